@@ -0,0 +1,95 @@
+/*
+ * Shared harness for the workload benchmarks run by `make bench`.
+ * Every workload comes in two versions: one on the collector, and a baseline on plain malloc and free.
+ * Each version runs in a child process of its own, so that the peak RSS it reports is its own.
+ * Pauses come from the collector's events, so the baseline has none to report.
+ */
+#include "impl.c"
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_PAUSES (1 << 20)
+#ifndef STEP_BUDGET
+#define STEP_BUDGET 256
+#endif
+
+/**
+ * A benchmark's workload, returning how many bytes of objects it wrote, counted the same way by both versions.
+ */
+typedef size_t (*workload_t)();
+
+static uint64_t* pauses;
+static size_t pause_count;
+
+static void record_pause(const gc_event* event, void* _) {
+    if (pause_count < MAX_PAUSES) pauses[pause_count++] = event->pause_ns;
+}
+
+static int compare_pauses(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec*1e-9;
+}
+
+/**
+ * Run one version of a workload, and report on it.
+ */
+static void measure(const char* name, const char* version, workload_t work, bool gc) {
+    if (gc) {
+        gc_config config = { .step_budget = STEP_BUDGET, .profile = true };
+        gc_init(&config);
+        pauses = malloc(MAX_PAUSES*sizeof(uint64_t));
+        gc_on_event(record_pause, NULL);
+    }
+    double t0 = now();
+    size_t bytes = work();
+    double t1 = now();
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    printf("%-14s %-7s %8.1f ms  %8.1f MB/s", name, version, (t1 - t0)*1e3, bytes/(t1 - t0)/1e6);
+    if (gc) {
+        qsort(pauses, pause_count, sizeof(uint64_t), compare_pauses);
+        double p50 = pause_count ? pauses[pause_count/2]/1e3 : 0;
+        double p99 = pause_count ? pauses[pause_count*99/100]/1e3 : 0;
+        double max = pause_count ? pauses[pause_count - 1]/1e3 : 0;
+        printf("  pauses %6zu  p50 %8.1f us  p99 %8.1f us  max %8.1f us", pause_count, p50, p99, max);
+    }
+    else printf("  %-62s", "");
+    printf("  peak RSS %7ld KiB\n", usage.ru_maxrss);
+    if (gc) {
+        gc_finish();
+        free(pauses);
+    }
+}
+
+/**
+ * Run one version of a workload in a child process, so that each starts from a fresh heap.
+ */
+static void run_child(const char* name, const char* version, workload_t work, bool gc) {
+    fflush(stdout);
+    pid_t child = fork();
+    if (child < 0) { error("%s:%d -- could not fork\n", __FILE__, __LINE__); }
+    if (!child) {
+        measure(name, version, work, gc);
+        fflush(stdout);
+        _exit(0);
+    }
+    int status;
+    waitpid(child, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status)) printf("%-14s %-7s failed\n", name, version);
+}
+
+/**
+ * Run both versions of a workload.
+ */
+static void compare(const char* name, workload_t with_gc, workload_t with_malloc) {
+    run_child(name, "gc", with_gc, true);
+    run_child(name, "malloc", with_malloc, false);
+}
@@ -0,0 +1,224 @@
+/*
+ * Persistent data structure churn benchmark.
+ * Runs random updates on a persistent linked list and on a persistent two-level map, keeping a window of
+ * versions alive, so that versions share most of their structure and die a little at a time.
+ * Only every few versions are kept, so that updates to the others can happen in place.
+ * The collector's versions update through `mut_gcobj`, which copies shared objects and changes fresh ones in place;
+ * they own each object they create or copy, as nothing else holds it until it's kept as a version.
+ * The baseline versions share structure by reference counting, and copy whatever is shared by hand.
+ */
+#include "bench.h"
+
+#define OPERATIONS 4000000
+#define VERSIONS 64
+#define KEEP_EVERY 4
+#define MAP_FANOUT 32
+
+static unsigned long seed;
+
+static unsigned long next_random() {
+    seed = seed*6364136223846793005UL + 1442695040888963407UL;
+    return seed >> 33;
+}
+
+static const size_t first_field = 0;
+static const gc_layout array_layout = { sizeof(gcobj), 1, &first_field };
+
+
+// ============ Linked List ============ //
+
+typedef struct { gcobj next; long val; } gc_cell;
+typedef struct malloc_cell { struct malloc_cell* next; long val; long refs; } malloc_cell;
+
+static const gc_layout cell_layout = { 0, 1, &first_field };
+
+static void bump_cell(void* p) {
+    ((gc_cell*)p)->val++;
+}
+
+/**
+ * Push onto the list half the time, pop a quarter of the time, and otherwise update the head.
+ */
+static size_t list_gc() {
+    size_t bytes = 0;
+    seed = 1;
+    //The latest versions, and then the current one.
+    gcobj* versions = gc_push_frame(VERSIONS + 1);
+    gcobj* list = &versions[VERSIONS];
+    for (long k = 0; k < OPERATIONS; ++k) {
+        unsigned long op = next_random() % 4;
+        if (op < 2 || !*list) {
+            //The old head is shared by the new one, and by whatever is popped back to it later.
+            gc_cell cell = { *list ? soft_copy_gcobj(*list) : NULL, k };
+            *list = own_gcobj(new_gcobj_layout(&cell, sizeof cell, &cell_layout, NULL));
+            bytes += sizeof cell;
+        }
+        elif (op == 2) *list = ((gc_cell*)gate_data(*list))->next;
+        else {
+            *list = own_gcobj(mut_gcobj(*list, bump_cell));
+            bytes += sizeof(gc_cell);
+        }
+        //Keeping a version shares it, so that later updates copy it.
+        if (!(k % KEEP_EVERY)) versions[k/KEEP_EVERY % VERSIONS] = soft_copy_gcobj(*list);
+    }
+    gc_pop_frame(versions);
+    return bytes;
+}
+
+static malloc_cell* retain_cell(malloc_cell* cell) {
+    if (cell) cell->refs++;
+    return cell;
+}
+
+static void release_cell(malloc_cell* cell) {
+    while (cell && !--cell->refs) {
+        malloc_cell* next = cell->next;
+        free(cell);
+        cell = next;
+    }
+}
+
+static malloc_cell* new_cell(malloc_cell* next, long val) {
+    malloc_cell* cell = malloc(sizeof(malloc_cell));
+    if (!cell) { out_of_memory; }
+    cell->next = retain_cell(next);
+    cell->val = val;
+    cell->refs = 1;
+    return cell;
+}
+
+static size_t list_malloc() {
+    size_t bytes = 0;
+    seed = 1;
+    malloc_cell* versions[VERSIONS] = {NULL};
+    malloc_cell* list = NULL;
+    for (long k = 0; k < OPERATIONS; ++k) {
+        unsigned long op = next_random() % 4;
+        malloc_cell* old = list;
+        if (op < 2 || !list) {
+            list = new_cell(old, k);
+            bytes += sizeof(gc_cell);
+        }
+        elif (op == 2) list = retain_cell(old->next);
+        else {
+            list = old->refs == 1 ? retain_cell(old) : new_cell(old->next, old->val);
+            list->val++;
+            bytes += sizeof(gc_cell);
+        }
+        release_cell(old);
+        if (k % KEEP_EVERY) continue;
+        release_cell(versions[k/KEEP_EVERY % VERSIONS]);
+        versions[k/KEEP_EVERY % VERSIONS] = retain_cell(list);
+    }
+    for (int k = 0; k < VERSIONS; ++k) release_cell(versions[k]);
+    release_cell(list);
+    return bytes;
+}
+
+
+// ============ Two-level Map ============ //
+
+typedef struct malloc_leaf { long val[MAP_FANOUT]; long refs; } malloc_leaf;
+typedef struct malloc_map { malloc_leaf* leaf[MAP_FANOUT]; long refs; } malloc_map;
+
+static uint update_at;   //key being updated
+static gcobj new_leaf;   //leaf to put into the map
+
+static void set_value(void* p) {
+    ((long*)p)[update_at % MAP_FANOUT]++;
+}
+
+static void set_leaf(void* p) {
+    ((gcobj*)p)[update_at / MAP_FANOUT] = new_leaf;
+}
+
+/**
+ * Bump the value at a random key, copying the path down to it.
+ */
+static size_t map_gc() {
+    size_t bytes = 0;
+    seed = 1;
+    gcobj* versions = gc_push_frame(VERSIONS + 2);
+    gcobj* map = &versions[VERSIONS];
+    gcobj* leaf = &versions[VERSIONS + 1];
+    {
+        gcobj* leaves = gc_push_frame(MAP_FANOUT);
+        long zero[MAP_FANOUT] = {0};
+        for (int i = 0; i < MAP_FANOUT; ++i) leaves[i] = soft_copy_gcobj(new_gcobj(zero, sizeof zero, NULL, NULL));
+        *map = new_gcobj_layout(leaves, MAP_FANOUT*sizeof(gcobj), &array_layout, NULL);
+        gc_pop_frame(leaves);
+    }
+    for (long k = 0; k < OPERATIONS; ++k) {
+        update_at = next_random() % (MAP_FANOUT*MAP_FANOUT);
+        *leaf = ((gcobj*)gate_data(*map))[update_at / MAP_FANOUT];
+        new_leaf = *leaf = own_gcobj(mut_gcobj(*leaf, set_value));
+        *map = own_gcobj(mut_gcobj(*map, set_leaf));
+        bytes += MAP_FANOUT*sizeof(long) + MAP_FANOUT*sizeof(gcobj);
+        //Keeping a version shares it whole, so that later updates copy the path down to what they change.
+        if (k % KEEP_EVERY) continue;
+        for (int i = 0; i < MAP_FANOUT; ++i) soft_copy_gcobj(((gcobj*)gate_data(*map))[i]);
+        versions[k/KEEP_EVERY % VERSIONS] = soft_copy_gcobj(*map);
+    }
+    gc_pop_frame(versions);
+    return bytes;
+}
+
+static void release_map(malloc_map* map) {
+    if (!map || --map->refs) return;
+    for (int i = 0; i < MAP_FANOUT; ++i) {
+        if (!--map->leaf[i]->refs) free(map->leaf[i]);
+    }
+    free(map);
+}
+
+static size_t map_malloc() {
+    size_t bytes = 0;
+    seed = 1;
+    malloc_map* versions[VERSIONS] = {NULL};
+    malloc_map* map = malloc(sizeof(malloc_map));
+    if (!map) { out_of_memory; }
+    map->refs = 1;
+    for (int i = 0; i < MAP_FANOUT; ++i) {
+        map->leaf[i] = calloc(1, sizeof(malloc_leaf));
+        if (!map->leaf[i]) { out_of_memory; }
+        map->leaf[i]->refs = 1;
+    }
+    for (long k = 0; k < OPERATIONS; ++k) {
+        uint at = next_random() % (MAP_FANOUT*MAP_FANOUT);
+        //Copy the map unless nothing else holds it, and the same for the leaf.
+        if (map->refs > 1) {
+            malloc_map* copy = malloc(sizeof(malloc_map));
+            if (!copy) { out_of_memory; }
+            memcpy(copy->leaf, map->leaf, sizeof copy->leaf);
+            for (int i = 0; i < MAP_FANOUT; ++i) copy->leaf[i]->refs++;
+            copy->refs = 1;
+            release_map(map);
+            map = copy;
+        }
+        malloc_leaf* leaf = map->leaf[at / MAP_FANOUT];
+        if (leaf->refs > 1) {
+            malloc_leaf* copy = malloc(sizeof(malloc_leaf));
+            if (!copy) { out_of_memory; }
+            memcpy(copy->val, leaf->val, sizeof copy->val);
+            copy->refs = 1;
+            leaf->refs--;
+            leaf = map->leaf[at / MAP_FANOUT] = copy;
+        }
+        leaf->val[at % MAP_FANOUT]++;
+        bytes += MAP_FANOUT*sizeof(long) + MAP_FANOUT*sizeof(gcobj);
+        if (k % KEEP_EVERY) continue;
+        release_map(versions[k/KEEP_EVERY % VERSIONS]);
+        versions[k/KEEP_EVERY % VERSIONS] = map;
+        map->refs++;
+    }
+    for (int k = 0; k < VERSIONS; ++k) release_map(versions[k]);
+    release_map(map);
+    return bytes;
+}
+
+
+int main() {
+    compare("list churn", list_gc, list_malloc);
+    compare("map churn", map_gc, map_malloc);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+/*
+ * Large-object churn benchmark.
+ * Keeps a window of objects alive, each too big for the nursery, replacing one at random at every step.
+ */
+#include "bench.h"
+
+#define OPERATIONS 200000
+#define LIVE 256
+#define MIN_BYTES 2048
+#define MAX_BYTES (64*1024)
+
+static unsigned long seed;
+static byte source[MAX_BYTES];
+
+static unsigned long next_random() {
+    seed = seed*6364136223846793005UL + 1442695040888963407UL;
+    return seed >> 33;
+}
+
+static size_t large_gc() {
+    size_t bytes = 0;
+    seed = 1;
+    gcobj* live = gc_push_frame(LIVE);
+    for (long k = 0; k < OPERATIONS; ++k) {
+        size_t size = MIN_BYTES + next_random() % (MAX_BYTES - MIN_BYTES);
+        live[next_random() % LIVE] = new_gcobj(source, size, NULL, NULL);
+        bytes += size;
+    }
+    gc_pop_frame(live);
+    return bytes;
+}
+
+static size_t large_malloc() {
+    size_t bytes = 0;
+    seed = 1;
+    void* live[LIVE] = {NULL};
+    for (long k = 0; k < OPERATIONS; ++k) {
+        size_t size = MIN_BYTES + next_random() % (MAX_BYTES - MIN_BYTES);
+        void* data = malloc(size);
+        if (!data) { out_of_memory; }
+        memcpy(data, source, size);
+        unsigned long at = next_random() % LIVE;
+        free(live[at]);
+        live[at] = data;
+        bytes += size;
+    }
+    for (int k = 0; k < LIVE; ++k) free(live[k]);
+    return bytes;
+}
+
+
+int main() {
+    compare("large objects", large_gc, large_malloc);
+    return 0;
+}
@@ -0,0 +1,103 @@
+/*
+ * Mark micro-benchmark.
+ * Times major-collection marking on a deep linked list and on a wide tree, both fully alive.
+ * The collector's internals are included directly, so that marking can be timed on its own.
+ */
+#include "impl.c"
+#include <time.h>
+
+#define LIST_CELLS 4000000
+#define LISTS 64
+#define TREE_FANOUT 16
+#define TREE_DEPTH 5
+
+typedef struct { gcobj next; long val; } cell;
+typedef struct { gcobj child[TREE_FANOUT]; } branch;
+
+static void trace_cell(const void* p) {
+    const cell* c = p;
+    if (c->next) gc_mark(c->next);
+}
+
+static void trace_branch(const void* p) {
+    const branch* b = p;
+    for (int i = 0; i < TREE_FANOUT; ++i) if (b->child[i]) gc_mark(b->child[i]);
+}
+
+static void trace_slot(const void* p) {
+    gcobj x = *(gcobj const*)p;
+    if (x) gc_mark(x);
+}
+
+static void trace_lists(const void* p) {
+    gcobj const* heads = p;
+    for (int i = 0; i < LISTS; ++i) if (heads[i]) gc_mark(heads[i]);
+}
+
+static gcobj build_tree(int depth) {
+    if (!depth) {
+        long leaf = 0;
+        return new_gcobj(&leaf, sizeof leaf, NULL, NULL);
+    }
+    branch b = {{NULL}};
+    gc_root(&b, trace_branch);
+    for (int i = 0; i < TREE_FANOUT; ++i) b.child[i] = build_tree(depth - 1);
+    gc_unroot(&b);
+    return new_gcobj(&b, sizeof b, trace_branch, NULL);
+}
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec*1e-9;
+}
+
+/**
+ * Time the best of a few major traces, sweeping in between so that the marks are cleared.
+ */
+static double time_marking() {
+    double best = 1e9;
+    for (int k = 0; k < 5; ++k) {
+        double t0 = now();
+        trace(1);
+        double t1 = now();
+        clean_registry(1);
+        gc_step(SIZE_MAX);
+        if (t1 - t0 < best) best = t1 - t0;
+    }
+    return best;
+}
+
+int main() {
+    gc_init(NULL);
+    //Deep lists: every object is only found by tracing the one before it.
+    //The lists are built interleaved at random, so that neighbours in a list aren't neighbours in memory.
+    gcobj heads[LISTS] = {NULL};
+    gc_root(heads, trace_lists);
+    unsigned long seed = 1;
+    for (long i = 0; i < LIST_CELLS; ++i) {
+        seed = seed*6364136223846793005UL + 1442695040888963407UL;
+        int k = seed >> 58;
+        cell c = { heads[k], i };
+        heads[k] = new_gcobj(&c, sizeof c, trace_cell, NULL);
+    }
+    gc_run();
+    gc_step(SIZE_MAX);
+    double t = time_marking();
+    printf("deep lists %8d objects  mark %6.1f ms  (%.2f ns/object)\n", LIST_CELLS, t*1e3, t*1e9/LIST_CELLS);
+    //A wide tree: lots of objects become grey at once.
+    gc_unroot(heads);
+    gcobj root = NULL;
+    gc_root(&root, trace_slot);
+    gc_run();
+    gc_step(SIZE_MAX);
+    root = build_tree(TREE_DEPTH);
+    gc_run();
+    gc_step(SIZE_MAX);
+    long nodes = 0;
+    for (long level = 1, d = 0; d <= TREE_DEPTH; ++d, level *= TREE_FANOUT) nodes += level;
+    t = time_marking();
+    printf("wide tree  %8ld objects  mark %6.1f ms  (%.2f ns/object)\n", nodes, t*1e3, t*1e9/nodes);
+    gc_finish();
+    return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * Update micro-benchmark.
+ * Times builder-style loops, which repeatedly update a single accumulator object through `mut_gcobj`,
+ * for a few object sizes (all small enough for the nursery), both when the accumulator is fresh and when every version is shared by a soft copy.
+ */
+#include "impl.c"
+#include <time.h>
+
+#define UPDATES 1000000
+
+static size_t words; //size of the accumulator being updated
+static size_t next;  //word the next update writes
+
+static void bump(void* p) {
+    long* at = p;
+    at[next] += 1;
+    next = (next + 1) % words;
+}
+
+static void trace_slot(const void* p) {
+    gcobj x = *(gcobj const*)p;
+    if (x) gc_mark(x);
+}
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec*1e-9;
+}
+
+/**
+ * Time a loop of updates, returning nanoseconds per update.
+ */
+static double build(bool share) {
+    long* zero = calloc(words, sizeof(long));
+    gcobj acc = own_gcobj(new_gcobj(zero, words*sizeof(long), NULL, NULL));
+    free(zero);
+    gc_root(&acc, trace_slot);
+    next = 0;
+    double t0 = now();
+    for (long i = 0; i < UPDATES; ++i) acc = mut_gcobj(share ? soft_copy_gcobj(acc) : acc, bump);
+    double t1 = now();
+    gc_unroot(&acc);
+    gc_run();
+    gc_step(SIZE_MAX);
+    return (t1 - t0)*1e9/UPDATES;
+}
+
+int main() {
+    gc_init(NULL);
+    size_t sizes[] = {8, 64, 512};
+    for (int s = 0; s < 3; ++s) {
+        words = sizes[s]/sizeof(long);
+        double fresh = build(false);
+        double shared = build(true);
+        printf("%5zu bytes  fresh %8.1f ns/update  shared %8.1f ns/update\n", sizes[s], fresh, shared);
+    }
+    gc_finish();
+    return 0;
+}
\ No newline at end of file
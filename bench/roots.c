@@ -0,0 +1,67 @@
+/*
+ * Root churn benchmark.
+ * Keeps many small objects alive, each through a root of its own, replacing one at random at every step:
+ * its root is dropped, and a new object is allocated and rooted in its place.
+ */
+#include "bench.h"
+
+#define OPERATIONS 4000000
+#define ROOTS 20000
+
+typedef struct { long val[4]; } payload;
+
+static unsigned long seed;
+
+static unsigned long next_random() {
+    seed = seed*6364136223846793005UL + 1442695040888963407UL;
+    return seed >> 33;
+}
+
+static void trace_slot(const void* p) {
+    gcobj x = *(gcobj const*)p;
+    if (x) gc_mark(x);
+}
+
+static size_t roots_gc() {
+    size_t bytes = 0;
+    seed = 1;
+    gcobj* slots = calloc(ROOTS, sizeof(gcobj));
+    gc_handle** handles = calloc(ROOTS, sizeof(gc_handle*));
+    if (!slots || !handles) { out_of_memory; }
+    for (long k = 0; k < OPERATIONS; ++k) {
+        unsigned long at = next_random() % ROOTS;
+        if (handles[at]) gc_drop_root(handles[at]);
+        payload p = {{k}};
+        slots[at] = new_gcobj(&p, sizeof p, NULL, NULL);
+        handles[at] = gc_add_root(&slots[at], trace_slot);
+        bytes += sizeof p;
+    }
+    for (long k = 0; k < ROOTS; ++k) if (handles[k]) gc_drop_root(handles[k]);
+    free(handles);
+    free(slots);
+    return bytes;
+}
+
+static size_t roots_malloc() {
+    size_t bytes = 0;
+    seed = 1;
+    payload** slots = calloc(ROOTS, sizeof(payload*));
+    if (!slots) { out_of_memory; }
+    for (long k = 0; k < OPERATIONS; ++k) {
+        unsigned long at = next_random() % ROOTS;
+        free(slots[at]);
+        slots[at] = malloc(sizeof(payload));
+        if (!slots[at]) { out_of_memory; }
+        *slots[at] = (payload){{k}};
+        bytes += sizeof(payload);
+    }
+    for (long k = 0; k < ROOTS; ++k) free(slots[k]);
+    free(slots);
+    return bytes;
+}
+
+
+int main() {
+    compare("many roots", roots_gc, roots_malloc);
+    return 0;
+}
@@ -0,0 +1,61 @@
+/*
+ * Sweep micro-benchmark.
+ * Builds a heap of 10M leaf gateways, then times marking and sweeping separately for a few survival rates.
+ * Sweeping is split into what's left in the pause, and the lazy sweep of everything else.
+ * The collector's internals are included directly, so that the sweep can be timed on its own.
+ */
+#include "impl.c"
+#include <time.h>
+
+#define GATES 10000000
+
+static gcobj* objs;
+static long keep_every; //keep one in this many alive; zero keeps none
+static long leaf;       //small enough to be kept in its gateway, so that there's no data to free
+
+static void trace_objs(const void* _) {
+    if (!keep_every) return;
+    for (long i = 0; i < GATES; i += keep_every) if (objs[i]) gc_mark(objs[i]);
+}
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec*1e-9;
+}
+
+int main() {
+    gc_init(NULL);
+    objs = calloc(GATES, sizeof(gcobj));
+    gc_root(objs, trace_objs);
+    long rates[] = {1, 64, 2, 0};
+    for (int r = 0; r < 4; ++r) {
+        //Refill the heap and get everything out of the young generation.
+        keep_every = 1;
+        //In a single batch, so as not to run a minor collection per nursery's worth.
+        if (!gc_begin_batch(GATES, 0)) { out_of_memory; }
+        for (long i = 0; i < GATES; ++i) objs[i] = batch_gcobj(&leaf, sizeof leaf, NULL, NULL);
+        gc_end_batch();
+        for (int k = 0; k < TENURE_AGE; ++k) minor_gc();
+        //Time a major collection that keeps the chosen fraction alive.
+        keep_every = rates[r];
+        double t0 = now();
+        trace(1);
+        double t1 = now();
+        clean_registry(1);
+        double t2 = now();
+        sweep_some(SIZE_MAX);
+        double t3 = now();
+        printf("keep %-6s  mark %6.1f ms  pause sweep %6.1f ms  lazy sweep %6.1f ms  (%.2f ns/gateway)\n",
+            rates[r] == 1 ? "all" : rates[r] == 64 ? "1/64" : rates[r] == 2 ? "1/2" : "none",
+            (t1 - t0)*1e3, (t2 - t1)*1e3, (t3 - t2)*1e3, (t3 - t1)*1e9/GATES);
+        //Whatever survived goes in the next round.
+        keep_every = 0;
+        major_gc();
+        //The collection opening the next batch mustn't find the dead gateways.
+        memset(objs, 0, GATES*sizeof(gcobj));
+    }
+    gc_finish();
+    free(objs);
+    return 0;
+}
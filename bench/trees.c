@@ -0,0 +1,127 @@
+/*
+ * Binary-trees benchmark.
+ * Builds and checks many short-lived complete binary trees of increasing depth, while one deep tree lives throughout.
+ * The collector's version roots trees under construction through the shadow stack.
+ * The batched version builds small subtrees a batch at a time instead, needing no roots for them.
+ */
+#include "bench.h"
+
+#define MIN_DEPTH 4
+#define MAX_DEPTH 16
+#define BATCH_DEPTH 8 //subtrees no deeper than this are built in a single batch
+
+typedef struct { gcobj left; gcobj right; } gc_node;
+typedef struct malloc_node { struct malloc_node* left; struct malloc_node* right; } malloc_node;
+
+static const size_t first_field = 0;
+static const gc_layout node_layout = { sizeof(gcobj), 1, &first_field };
+
+
+static gcobj build_gc(int depth) {
+    gcobj* frame = gc_push_frame(2);
+    if (depth) {
+        frame[0] = build_gc(depth - 1);
+        frame[1] = build_gc(depth - 1);
+    }
+    gc_node node = { frame[0], frame[1] };
+    gcobj x = new_gcobj_layout(&node, sizeof node, &node_layout, NULL);
+    gc_pop_frame(frame);
+    return x;
+}
+
+static gcobj build_batched(int depth) {
+    gc_node node = { NULL, NULL };
+    if (depth) {
+        node.left = build_batched(depth - 1);
+        node.right = build_batched(depth - 1);
+    }
+    return batch_gcobj_layout(&node, sizeof node, &node_layout, NULL);
+}
+
+static gcobj build_batch(int depth) {
+    if (depth <= BATCH_DEPTH) {
+        size_t nodes = ((size_t)2 << depth) - 1;
+        if (!gc_begin_batch(nodes, nodes*sizeof(gc_node))) { out_of_memory; }
+        gcobj x = build_batched(depth);
+        gc_end_batch();
+        return x;
+    }
+    gcobj* frame = gc_push_frame(2);
+    frame[0] = build_batch(depth - 1);
+    frame[1] = build_batch(depth - 1);
+    gc_node node = { frame[0], frame[1] };
+    gcobj x = new_gcobj_layout(&node, sizeof node, &node_layout, NULL);
+    gc_pop_frame(frame);
+    return x;
+}
+
+static long check_gc(gcobj x) {
+    const gc_node* node = gate_data(x);
+    return 1 + (node->left ? check_gc(node->left) + check_gc(node->right) : 0);
+}
+
+static size_t trees_with(gcobj (*build)(int depth)) {
+    size_t nodes = 0;
+    gcobj* frame = gc_push_frame(2);
+    frame[0] = build(MAX_DEPTH);
+    for (int depth = MIN_DEPTH; depth <= MAX_DEPTH; depth += 2) {
+        for (long k = 0, n = 1L << (MAX_DEPTH - depth + MIN_DEPTH); k < n; ++k) {
+            frame[1] = build(depth);
+            nodes += check_gc(frame[1]);
+        }
+    }
+    nodes += check_gc(frame[0]);
+    gc_pop_frame(frame);
+    return nodes*sizeof(gc_node);
+}
+
+static size_t trees_gc() {
+    return trees_with(build_gc);
+}
+
+static size_t trees_batch() {
+    return trees_with(build_batch);
+}
+
+
+static malloc_node* build_malloc(int depth) {
+    malloc_node* node = malloc(sizeof(malloc_node));
+    if (!node) { out_of_memory; }
+    node->left = depth ? build_malloc(depth - 1) : NULL;
+    node->right = depth ? build_malloc(depth - 1) : NULL;
+    return node;
+}
+
+static long check_malloc(const malloc_node* node) {
+    return 1 + (node->left ? check_malloc(node->left) + check_malloc(node->right) : 0);
+}
+
+static void free_malloc(malloc_node* node) {
+    if (node->left) {
+        free_malloc(node->left);
+        free_malloc(node->right);
+    }
+    free(node);
+}
+
+static size_t trees_malloc() {
+    size_t nodes = 0;
+    malloc_node* long_lived = build_malloc(MAX_DEPTH);
+    for (int depth = MIN_DEPTH; depth <= MAX_DEPTH; depth += 2) {
+        for (long k = 0, n = 1L << (MAX_DEPTH - depth + MIN_DEPTH); k < n; ++k) {
+            malloc_node* tree = build_malloc(depth);
+            nodes += check_malloc(tree);
+            free_malloc(tree);
+        }
+    }
+    nodes += check_malloc(long_lived);
+    free_malloc(long_lived);
+    return nodes*sizeof(malloc_node);
+}
+
+
+int main() {
+    compare("binary-trees", trees_gc, trees_malloc);
+    run_child("binary-trees", "batch", trees_batch, true);
+    return 0;
+}
\ No newline at end of file
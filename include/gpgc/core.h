@@ -1,12 +1,66 @@
 #ifndef CPGC_CORE_H
 #define CPGC_CORE_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 // ============ Initialization ============ //
+/**
+ * Options for `gc_init`.
+ * Zero in any field means the default.
+ */
+typedef struct gc_config {
+    /**
+     * Number of threads marking during major collections, counting the thread that owns the heap.
+     * The default is one, so that tracing happens only in the owning thread.
+     * With more than one, tracers are called from other threads, and so must only read the object and call `gc_mark`.
+     */
+    int marker_threads;
+    /**
+     * How much work (in gateways traced or swept) each allocation puts towards an incremental major collection.
+     * The default is zero, which does a major collection all at once whenever one is due (see `heap_growth`).
+     */
+    int step_budget;
+    /**
+     * Nonzero to have major collections compact tenure, moving objects out of sparsely used pages
+     * so that the pages can be given back to the system.
+     * Pinned objects are never moved.
+     */
+    int compact;
+    /**
+     * Nonzero to time each collection, see `gc_get_stats` and `gc_on_event`.
+     * Without it, every time reported is zero, but the counts are still kept.
+     */
+    int profile;
+    /**
+     * Limit on the bytes of object data outside the nursery and survivor spaces, see `gc_stats`.
+     * An allocation that would go over it runs a full major collection first, and fails if that didn't make room.
+     * The default is no limit.
+     */
+    size_t max_heap_size;
+    /**
+     * Bytes in the nursery to start with.
+     * The nursery grows while many of its objects survive minor collections, and shrinks while few do.
+     */
+    size_t nursery_size;
+    /**
+     * Nonzero to keep the nursery at its starting size.
+     */
+    int fixed_nursery;
+    /**
+     * How much may be tenured after a major collection before the next one is due,
+     * as a percent of what the last one left alive; the default is 100.
+     * Due collections are done a step at a time with a `step_budget`, and all at once without one.
+     */
+    int heap_growth;
+} gc_config;
+
 /**
  * Ready the system for garbage collection.
+ * Pass `NULL` for the default configuration.
  * Any use of these gc functinos results in undefined behavior if `gc_init` hasn't yet been called.
  */
-void gc_init();
+void gc_init(const gc_config*);
 
 /**
  * Teardown the garbage collection system, including running finalizers on all living objects.
@@ -38,6 +92,22 @@ typedef void (*tracer_t)(const void*);
  */
 typedef void (*finalizer_t)(void*);
 
+/**
+ * Description of where the gcobjs are inside an object, as a faster alternative to a tracer function.
+ * The collector reads these itself, so tracing an object with a layout takes no calls into user code.
+ * The gcobjs are at each of the given byte offsets from the start of the object.
+ * With a nonzero `stride`, the offsets instead repeat every `stride` bytes, to the end of the object.
+ *   - a leaf object, with no gcobjs inside, has no offsets at all
+ *   - an array of gcobjs has a single offset of zero, and a stride of `sizeof(gcobj)`
+ * Each offset must leave room for a whole gcobj inside the object, or inside each stride.
+ * Layouts with offsets must stay valid for as long as any object made with them.
+ */
+typedef struct gc_layout {
+    size_t stride;
+    size_t count;
+    const size_t* offsets;
+} gc_layout;
+
 
 // ============ Marking ============ //
 /**
@@ -45,6 +115,13 @@ typedef void (*finalizer_t)(void*);
  */
 void gc_mark(gcobj);
 
+/**
+ * Write barrier: record that a gc-managed object has been changed in place.
+ * Until the next few minor collections are done, the object is traced as if it were a root.
+ * This is only needed when changing objects other than through `set_gcobj`.
+ */
+void gc_touch(gcobj);
+
 
 // ============ Root Management ============ //
 /**
@@ -54,9 +131,52 @@ void gc_root(void*, tracer_t);
 
 /**
  * Remove an object from the list of root objects.
+ * This searches the roots, so `gc_add_root` suits roots that come and go often.
  */
 void gc_unroot(void*);
 
+/**
+ * Handle on a root added by `gc_add_root`.
+ */
+typedef struct gc_handle gc_handle;
+
+/**
+ * As `gc_root`, but return a handle that removes the root in constant time, see `gc_drop_root`.
+ */
+gc_handle* gc_add_root(void*, tracer_t);
+
+/**
+ * Remove a root added by `gc_add_root`; the handle is no longer valid afterwards.
+ */
+void gc_drop_root(gc_handle*);
+
+/**
+ * Push a frame of `n` root slots onto this thread's shadow stack, and return the first slot.
+ * The slots start out `NULL`; whatever is stored in them stays alive until the frame is popped.
+ */
+gcobj* gc_push_frame(size_t n);
+
+/**
+ * Pop a frame pushed by `gc_push_frame`, along with any pushed after it.
+ */
+void gc_pop_frame(gcobj* frame);
+
+
+// ============ Collection ============ //
+/**
+ * Perform a major garbage collection in this thread.
+ * Most dead objects are only finalized and freed afterwards, as new gateways need their room, or by `gc_step`.
+ */
+void gc_run();
+
+/**
+ * Do up to about `budget` gateways' worth of an incremental major collection, starting one if none is in progress.
+ * A major collection still being swept counts as in progress.
+ * Return nonzero once the collection is complete.
+ * Marking is finished in a single step, which rescans the roots and the young generation.
+ */
+int gc_step(size_t budget);
+
 
 // ============ Object Manipulation ============ //
 /**
@@ -67,22 +187,115 @@ gcobj new_gcobj( const void* source, size_t bytes
                , finalizer_t);
 /**
  * Create a new gc-managed object from `source`, causing the input to become invalid.
+ * The source must come from malloc, or from `gc_alloc_large`.
+ * If the heap limit leaves no room for it, then return `NULL`, and the source is still the caller's.
  */
 gcobj to_gcobj( void* source, size_t bytes
                , tracer_t
                , finalizer_t);
 
+/**
+ * As `new_gcobj`, but traced according to a layout instead of a function.
+ */
+gcobj new_gcobj_layout( const void* source, size_t bytes
+                      , const gc_layout*
+                      , finalizer_t);
+/**
+ * As `to_gcobj`, but traced according to a layout instead of a function.
+ */
+gcobj to_gcobj_layout( void* source, size_t bytes
+                     , const gc_layout*
+                     , finalizer_t);
+
+/**
+ * Set aside room for `count` new objects whose sizes total `bytes`, to be created by `batch_gcobj`.
+ * Any collection needed to make room happens now, and none happens while the batch is open,
+ * so objects created in the batch need no rooting for one another's creation.
+ * No other gc function that allocates may be called until the batch is closed by `gc_end_batch`.
+ * If the heap limit can't be met even after a major collection, then return zero, and no batch is opened.
+ */
+int gc_begin_batch(size_t count, size_t bytes);
+
+/**
+ * As `new_gcobj`, but taking its room from the open batch, with no checks for room and no collection.
+ * Going over the batch's count or bytes is an error.
+ */
+gcobj batch_gcobj( const void* source, size_t bytes
+                 , tracer_t
+                 , finalizer_t);
+
+/**
+ * As `batch_gcobj`, but traced according to a layout instead of a function.
+ */
+gcobj batch_gcobj_layout( const void* source, size_t bytes
+                        , const gc_layout*
+                        , finalizer_t);
+
+/**
+ * Close the open batch, giving up whatever room it has left.
+ */
+void gc_end_batch();
+
+/**
+ * Allocate a buffer in the large object space, to be filled in and handed to `to_gcobj`,
+ * which then adopts it as it is, instead of taking it as memory from malloc.
+ * Each buffer gets pages of its own, which all go back to the system once its object dies.
+ * If the system is out of memory, then return `NULL`.
+ */
+void* gc_alloc_large(size_t bytes);
+
+/**
+ * Give back a buffer from `gc_alloc_large` that was never handed to `to_gcobj`.
+ */
+void gc_free_large(void*);
+
 /**
  * Perform a hardware-accelerated query on a gc-managed object.
+ * `f` is handed the object's data and `res`, where it should put its answer.
  */
-void ask_gcobj(gcobj, void (*f)(const void* obj, void* res));
+void ask_gcobj(gcobj, void (*f)(const void* obj, void* res), void* res);
 
 /**
  * Update a gc-managed object and return the updated version.
- * This is a persistant update, meaning the input object is unmodified.
+ * This is a persistant update, meaning the input object is unmodified, unless the input is fresh:
+ * a gcobj is fresh from when it's passed to `own_gcobj` until it's passed to `soft_copy_gcobj`,
+ * and as nothing else can see it, it's updated in place and returned, saving a copy.
+ * The copy made for an object that isn't fresh isn't fresh either.
  */
 gcobj mut_gcobj(gcobj, void (*f)(void* obj));
 
+/**
+ * Promise that the caller holds the only reference to a gc-managed object, returning the same gcobj, now fresh
+ * (see `mut_gcobj`), so that updates to it are made in place until it's shared through `soft_copy_gcobj`.
+ * Interned objects may not be made fresh.
+ */
+gcobj own_gcobj(gcobj);
+
+/**
+ * Share a gc-managed object, returning the same gcobj, which is no longer fresh (see `mut_gcobj`).
+ * This costs nothing beyond a bit flip; the data is only copied if the object is updated later.
+ */
+gcobj soft_copy_gcobj(gcobj);
+
+/**
+ * Promise that a gc-managed object will never change again, so that once tenured, it may share its data with any
+ * other such object holding the same bytes.
+ * The gcobj itself stays distinct, and is returned no longer fresh (see `mut_gcobj`); changing it in place is an error.
+ * Objects with a finalizer, or too big for a tenure page, keep data of their own all the same.
+ */
+gcobj intern_gcobj(gcobj);
+
+/**
+ * Copy a gc-managed object into a new object, which isn't fresh (see `own_gcobj`), whatever the original was.
+ */
+gcobj hard_copy_gcobj(gcobj);
+
+/**
+ * Update a gc-managed object in place, so that every holder of the gcobj sees the change.
+ * Use this for mutable objects; it takes care of informing the collector (see `gc_touch`).
+ */
+void set_gcobj(gcobj, void (*f)(void* obj));
+
 /**
  * Copy data out of gc-managed memory.
  */
@@ -100,4 +313,151 @@ void pin_gcobj(gcobj);
 void unpin_gcobj(gcobj);
 
 
+// ============ Weak References ============ //
+/**
+ * A reference to a gc-managed object that doesn't keep it alive.
+ * Weak references belong to the user, and stay valid (if cleared) after their target dies, until `free_weak`.
+ * Since gcobjs never move, a table keyed by gcobj can hold ephemerons as its entries, and shrinks as its keys die.
+ */
+typedef struct gc_weak gc_weak;
+
+/**
+ * Make a weak reference to a gc-managed object.
+ */
+gc_weak* new_weak(gcobj target);
+
+/**
+ * Make an ephemeron: a weak reference to `key` that also holds on to `value`, but only for as long as `key` is alive.
+ * A value pointing back at its own key doesn't keep the key alive.
+ */
+gc_weak* new_ephemeron(gcobj key, gcobj value);
+
+/**
+ * Get the target of a weak reference (the key of an ephemeron), or `NULL` once it's been collected.
+ */
+gcobj weak_target(gc_weak*);
+
+/**
+ * Get the value of an ephemeron, or `NULL` once its key has been collected, or if it's a plain weak reference.
+ */
+gcobj weak_value(gc_weak*);
+
+/**
+ * Give a weak reference back, whether or not it's been cleared.
+ */
+void free_weak(gc_weak*);
+
+
+// ============ Sharing Between Threads ============ //
+/**
+ * A thread's gc system, as seen from other threads, so that they can send it objects.
+ */
+typedef struct gc_heap gc_heap;
+
+/**
+ * Get this thread's heap, to hand to threads that will send objects here.
+ */
+gc_heap* gc_this_heap();
+
+/**
+ * Hand the graph of objects reachable from `root` to another thread's heap, without copying any of it.
+ * The objects stay where they are, and the other heap holds on to them until it finds them dead.
+ * From now on, every object in the graph must be treated as immutable, by both threads:
+ * no `set_gcobj` or `gc_touch`, and `mut_gcobj` always makes a copy.
+ * The sending thread must not call `gc_finish` while the graph may still be in use elsewhere.
+ */
+void gc_send(gc_heap* to, gcobj root);
+
+/**
+ * Take the next object graph sent to this thread, or `NULL` if nothing has arrived.
+ * This is a safe point: graphs sent here only become part of this heap during a call to `gc_receive`.
+ */
+gcobj gc_receive();
+
+
+// ============ Frozen Objects ============ //
+/**
+ * Copy a gc-managed object into the frozen heap, shared by every thread, and return the frozen copy.
+ * Everything the object references must be frozen already, so graphs are frozen from the leaves up.
+ * Frozen objects are immutable, are never traced by a thread's own collections, and are only freed once
+ * `gc_collect_frozen` finds that no heap can reach them.
+ * Freezing an object that's already frozen just returns it.
+ */
+gcobj gc_freeze(gcobj);
+
+/**
+ * Start a collection of the frozen heap, then run a major collection in this thread.
+ * The frozen heap is swept once every running heap has finished marking a major collection started since.
+ * Pinned frozen objects are kept, along with everything they reference.
+ * When the last heap is finished, the frozen heap is finalized and freed along with it.
+ */
+void gc_collect_frozen();
+
+
+// ============ Instrumentation ============ //
+/**
+ * Which kind of collection a `gc_event` describes.
+ */
+typedef enum gc_event_kind {
+    GC_MINOR_EVENT,      //a minor collection
+    GC_MAJOR_EVENT,      //a major collection done all at once, apart from the minor collection it starts with
+    GC_INCREMENTAL_EVENT //an incremental major collection, reported once its sweep is done
+} gc_event_kind;
+
+/**
+ * What happened during a single collection, see `gc_on_event`.
+ * Times are in nanoseconds, and are only measured when profiling (see `gc_config`); otherwise they're zero.
+ */
+typedef struct gc_event {
+    int kind;               //see `gc_event_kind`
+    uint64_t pause_ns;      //from start to end, or for incremental collections, the longest step
+    uint64_t mark_ns;
+    uint64_t sweep_ns;      //including finalization
+    uint64_t finalize_ns;   //running finalizers
+    size_t allocated_bytes; //since the previous collection
+    size_t promoted_bytes;  //tenured during the collection
+    size_t young_bytes;     //in the nursery and survivor space, for minor collections
+    size_t survived_bytes;  //of those, found alive
+    double survival_rate;   //`survived_bytes/young_bytes`, or zero if there were none
+    size_t gateways;        //in use afterwards
+    size_t blocks;          //of the gateway registry, afterwards
+    size_t tenured_bytes;   //of data outside the nursery and survivor spaces, afterwards
+} gc_event;
+
+/**
+ * Running totals for this thread's heap, see `gc_get_stats`.
+ * Times are only measured when profiling, as for `gc_event`.
+ */
+typedef struct gc_stats {
+    size_t minor_collections;
+    size_t major_collections; //incremental or not
+    uint64_t pause_ns;        //over all collections done all at once, and all incremental steps
+    uint64_t max_pause_ns;
+    uint64_t mark_ns;
+    uint64_t sweep_ns;        //including finalization, and sweeping left for later by major collections
+    uint64_t finalize_ns;
+    size_t allocated_bytes;
+    size_t promoted_bytes;
+    size_t interned_bytes;    //promoted, but found equal to interned data already tenured, so shared
+    size_t young_bytes;       //over all minor collections, so the survival rate is `survived_bytes/young_bytes`
+    size_t survived_bytes;
+    //current
+    size_t gateways;
+    size_t blocks;
+    size_t tenured_bytes;
+} gc_stats;
+
+/**
+ * Get the statistics of this thread's heap so far.
+ */
+void gc_get_stats(gc_stats*);
+
+/**
+ * Have `f` called with each collection's `gc_event`, or stop if `f` is `NULL`.
+ * It's called at the end of the collection, so it must not use the gc system.
+ */
+void gc_on_event(void (*f)(const gc_event*, void* data), void* data);
+
+
+
 #endif
\ No newline at end of file
@@ -2,20 +2,103 @@
 #define ALLOC_H
 
 
+/**
+ * Round a size up so that whatever is allocated after it stays suitably aligned for any type.
+ */
+static inline size_t align_size(size_t bytes);
+
+/**
+ * Test whether some data lives in this thread's nursery.
+ */
+static inline bool in_nursery(const void* data);
+
+/**
+ * How big the nursery is right now.
+ */
+static inline size_t nursery_size();
+
+/**
+ * Grow or shrink the nursery in place, up to `MAX_NURSERY_SIZE`.
+ * It must be empty, as it is right after a minor collection.
+ */
+static void resize_nursery(size_t bytes);
+
+/**
+ * Once a minor collection has moved everything alive out of the nursery, start filling it again from the bottom.
+ * Pages that went unused since the last minor collection have their memory given back.
+ */
+static void empty_nursery();
+
+/**
+ * Count young data kept outside the nursery towards filling it, first doing a minor collection if that would overfill it.
+ */
+static void charge_nursery(size_t bytes);
+
 /**
  * Allocate space for an object.
- * If the object is small enough, it goes in the nursery, otherwise it goes into tenure.
+ * If the object is small enough, it goes in the nursery, otherwise it's left to malloc,
+ * or for the largest objects, to the large object space.
  * If a minor collection is needed to free up space in the nursery, then this is done.
+ * If the system is out of memory, or the heap limit can't be met even after a major collection, then return `NULL`.
+ */
+static void* gc_alloc(size_t bytes);
+
+/**
+ * Open a batch of `count` allocations totalling `bytes`, to be made with `batch_alloc`.
+ * Any collection that's needed to make room for them happens now.
+ * If the heap limit can't be met even after a major collection, then return false.
+ */
+static bool reserve_batch(size_t count, size_t bytes);
+
+/**
+ * Allocate space for an object in the open batch, as `gc_alloc` would, but without ever collecting.
  * If the system is out of memory, then return `NULL`.
  */
-static void* gc_alloc(void* source, size_t bytes);
+static void* batch_alloc(size_t bytes);
+
+/**
+ * Take an object that needs no room from the open batch, counting `bytes` towards filling the nursery
+ * as `charge_nursery` would, but without ever collecting.
+ */
+static void batch_charge(size_t bytes);
 
 /**
- * Move an object from the nursery to tenured space, updating its gateway.
+ * Close the open batch, giving up whatever is left of it.
+ */
+static void end_batch();
+
+/**
+ * Move a young object that has survived a minor collection, updating its gateway.
+ * It goes into a survivor space until it has survived `TENURE_AGE` minor collections, then into tenured space.
  * If the object is already tenured, then do nothing.
  */
 static void gc_age(gcobj);
 
+/**
+ * Tenure a young object straight away, whatever its age.
+ * Whatever it points to must be tenured too, before the next minor collection.
+ */
+static void gc_promote(gcobj);
+
+/**
+ * Before survivors are moved, decide whether they can go into a survivor space.
+ * Pass the total size of live objects in the nursery and survivor spaces.
+ * If they won't all fit, then all of them are tenured instead.
+ * Otherwise, an object tenured early could be left pointing at younger objects that minor collections still move.
+ */
+static void plan_survivors(size_t bytes);
+
+/**
+ * Swap the roles of the survivor spaces, emptying the one that will receive the next survivors.
+ * Done after every minor collection, once everything in the old survivor space has been moved out.
+ */
+static void flip_survivors();
+
+/**
+ * How much of the nursery and the survivor space about to be emptied is in use.
+ */
+static size_t young_space_used();
+
 /**
  * Perform finalization and free memory for a gc-managed object.
  */
@@ -3,6 +3,7 @@
 
 #include <assert.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -28,6 +29,11 @@ typedef ptrdiff_t word_diff;
 /** Type for NUL-terminated char*, as distinct from arbitrary char*. */
 typedef char* cstring;
 
+/** Storage class for data private to each thread. */
+#ifndef thread_local
+#define thread_local _Thread_local
+#endif
+
 // ====== Simple Stuff ======
 
 /** Cuts down on a few characters. Same as `else if`. */
@@ -60,6 +66,9 @@ typedef char* cstring;
 /** Mark unreachable/unimplemented sections of code cause loud failure. */
 #define unreachable error("%s:%d -- unreachable code\n", __FILE__, __LINE__)
 
+/** Loud failure when the system allocator gives up on us. */
+#define out_of_memory error("%s:%d -- out of memory\n", __FILE__, __LINE__)
+
 #define unimplemented error(\
     "Unimplemented: %s,%d.\n\tPlease help us by contributing at %s.\n",\
     __FILE__, __LINE__, CONTRIB_URL)
@@ -0,0 +1,71 @@
+#ifndef FROZEN_H
+#define FROZEN_H
+
+
+/**
+ * Copy a gc-managed object into the frozen heap, shared by every thread, and return the frozen copy.
+ * Everything the object references must be frozen already, so graphs are frozen from the leaves up.
+ * Frozen objects are immutable, are never traced by a thread's own collections, and are only freed once
+ * `gc_collect_frozen` finds that no heap can reach them.
+ * Freezing an object that's already frozen just returns it.
+ */
+gcobj gc_freeze(gcobj);
+
+/**
+ * Start a collection of the frozen heap, then run a major collection in this thread.
+ * The frozen heap is swept once every running heap has finished marking a major collection started since.
+ * Pinned frozen objects are kept, along with everything they reference.
+ * When the last heap is finished, the frozen heap is finalized and freed along with it.
+ */
+void gc_collect_frozen();
+
+
+/**
+ * The heap of frozen objects, and the state of its collection.
+ */
+typedef struct frozen_heap_t frozen_heap_t;
+
+/**
+ * Get a handle to the frozen heap, which is shared by all threads.
+ */
+static inline frozen_heap_t* getFrozen();
+
+/**
+ * Count this thread's heap among those a collection of the frozen heap waits for.
+ */
+static void join_frozen();
+
+/**
+ * Stop counting this thread's heap, tearing down the frozen heap if it was the last.
+ */
+static void leave_frozen();
+
+/**
+ * Note, as a major collection starts marking, whether its marks will count towards a collection of the frozen heap.
+ */
+static void begin_frozen_marks();
+
+/**
+ * Mark a frozen gateway as reachable from this heap, if the frozen heap is being collected.
+ * Safe to call from any thread; return whether it was newly marked.
+ */
+static bool mark_frozen(gcobj);
+
+/**
+ * As `mark_frozen`, for a gateway reached by tracing a frozen object, or one about to be frozen.
+ * Done as stage 4, with the frozen heap's lock held.
+ */
+static void trace_frozen(gcobj);
+
+/**
+ * Pin or unpin a frozen gateway, see `pin_gcobj`.
+ */
+static void pin_frozen(gcobj, int by);
+
+/**
+ * Once a major collection is done marking, let the frozen heap know, sweeping it if this was the last heap to.
+ */
+static void report_frozen();
+
+
+#endif
\ No newline at end of file
@@ -24,6 +24,22 @@ typedef void (*tracer_t)(const void*);
  */
 typedef void (*finalizer_t)(void*);
 
+/**
+ * Description of where the gcobjs are inside an object, as a faster alternative to a tracer function.
+ * The collector reads these itself, so tracing an object with a layout takes no calls into user code.
+ * The gcobjs are at each of the given byte offsets from the start of the object.
+ * With a nonzero `stride`, the offsets instead repeat every `stride` bytes, to the end of the object.
+ *   - a leaf object, with no gcobjs inside, has no offsets at all
+ *   - an array of gcobjs has a single offset of zero, and a stride of `sizeof(gcobj)`
+ * Each offset must leave room for a whole gcobj inside the object, or inside each stride.
+ * Layouts with offsets must stay valid for as long as any object made with them.
+ */
+typedef struct gc_layout {
+    size_t stride;
+    size_t count;
+    const size_t* offsets;
+} gc_layout;
+
 
 /**
  * Create a new gc-managed object from `source`, leaving the input data valid.
@@ -33,22 +49,94 @@ gcobj new_gcobj( const void* source, size_t bytes
                , finalizer_t);
 /**
  * Create a new gc-managed object from `source`, causing the input to become invalid.
+ * The source must come from malloc, or from `gc_alloc_large`.
+ * If the heap limit leaves no room for it, then return `NULL`, and the source is still the caller's.
  */
 gcobj to_gcobj( void* source, size_t bytes
                , tracer_t
                , finalizer_t);
 
+/**
+ * As `new_gcobj`, but traced according to a layout instead of a function.
+ */
+gcobj new_gcobj_layout( const void* source, size_t bytes
+                      , const gc_layout*
+                      , finalizer_t);
+/**
+ * As `to_gcobj`, but traced according to a layout instead of a function.
+ */
+gcobj to_gcobj_layout( void* source, size_t bytes
+                     , const gc_layout*
+                     , finalizer_t);
+
+/**
+ * Set aside room for `count` new objects whose sizes total `bytes`, to be created by `batch_gcobj`.
+ * Any collection needed to make room happens now, and none happens while the batch is open,
+ * so objects created in the batch need no rooting for one another's creation.
+ * No other gc function that allocates may be called until the batch is closed by `gc_end_batch`.
+ * If the heap limit can't be met even after a major collection, then return zero, and no batch is opened.
+ */
+int gc_begin_batch(size_t count, size_t bytes);
+
+/**
+ * As `new_gcobj`, but taking its room from the open batch, with no checks for room and no collection.
+ * Going over the batch's count or bytes is an error.
+ */
+gcobj batch_gcobj( const void* source, size_t bytes
+                 , tracer_t
+                 , finalizer_t);
+
+/**
+ * As `batch_gcobj`, but traced according to a layout instead of a function.
+ */
+gcobj batch_gcobj_layout( const void* source, size_t bytes
+                        , const gc_layout*
+                        , finalizer_t);
+
+/**
+ * Close the open batch, giving up whatever room it has left.
+ */
+void gc_end_batch();
+
 /**
  * Perform a hardware-accelerated query on a gc-managed object.
+ * `f` is handed the object's data and `res`, where it should put its answer.
  */
-void ask_gcobj(gcobj, void (*f)(const void* obj, void* res));
+void ask_gcobj(gcobj, void (*f)(const void* obj, void* res), void* res);
 
 /**
  * Update a gc-managed object and return the updated version.
- * This is a persistant update, meaning the input object is unmodified.
+ * This is a persistant update, meaning the input object is unmodified, unless the input is fresh:
+ * a gcobj is fresh from when it's passed to `own_gcobj` until it's passed to `soft_copy_gcobj`,
+ * and as nothing else can see it, it's updated in place and returned, saving a copy.
+ * The copy made for an object that isn't fresh isn't fresh either.
  */
 gcobj mut_gcobj(gcobj, void (*f)(void* obj));
 
+/**
+ * Promise that the caller holds the only reference to a gc-managed object, returning the same gcobj, now fresh
+ * (see `mut_gcobj`), so that updates to it are made in place until it's shared through `soft_copy_gcobj`.
+ * Interned objects may not be made fresh.
+ */
+gcobj own_gcobj(gcobj);
+
+/**
+ * Share a gc-managed object, returning the same gcobj, which is no longer fresh (see `mut_gcobj`).
+ * This costs nothing beyond a bit flip; the data is only copied if the object is updated later.
+ */
+gcobj soft_copy_gcobj(gcobj);
+
+/**
+ * Copy a gc-managed object into a new object, which isn't fresh (see `own_gcobj`), whatever the original was.
+ */
+gcobj hard_copy_gcobj(gcobj);
+
+/**
+ * Update a gc-managed object in place, so that every holder of the gcobj sees the change.
+ * Use this for mutable objects; it takes care of informing the collector (see `gc_touch`).
+ */
+void set_gcobj(gcobj, void (*f)(void* obj));
+
 /**
  * Copy data out of gc-managed memory.
  */
@@ -66,14 +154,18 @@ void pin_gcobj(gcobj);
 void unpin_gcobj(gcobj);
 
 
+/**
+ * How the collector traces a gateway's data: either a `tracer_t`, or a `gc_layout` that it reads itself.
+ * Which one is given by a `trace_kind`.
+ */
+typedef union trace_plan trace_plan;
+
 /**
  * Allocate a gateway and return a gcobj handle to it.
+ * The new gateway is young, and has no data yet.
  * Remember: `gcobj` remains valid as long as the object is tracable from the roots of the gc system.
  */
-static gcobj fresh_gateway();
-
-//TODO inline functinos to update gcobjs
-
+static gcobj fresh_gateway(size_t bytes, byte how, trace_plan, finalizer_t);
 
 
 #endif
\ No newline at end of file
@@ -1,10 +1,30 @@
 #include "common.h"
 #include "init.h"
+#include "reserve.h"
 #include "gateway.h"
 #include "alloc.h"
+#include "tenure.h"
+#include "intern.h"
+#include "large.h"
 #include "trace.h"
+#include "markers.h"
+#include "weak.h"
+#include "share.h"
+#include "frozen.h"
+#include "stats.h"
+#include "policy.h"
 
-#include "init.inc"
+#include "reserve.inc"
 #include "gateway.inc"
 #include "alloc.inc"
-#include "trace.inc"
\ No newline at end of file
+#include "tenure.inc"
+#include "intern.inc"
+#include "large.inc"
+#include "trace.inc"
+#include "markers.inc"
+#include "weak.inc"
+#include "share.inc"
+#include "frozen.inc"
+#include "stats.inc"
+#include "policy.inc"
+#include "init.inc"
\ No newline at end of file
@@ -2,19 +2,54 @@
 #define INIT_H
 
 
-//REFAC when we make these configable, move to their own location
-static int MAX_HEAP_SIZE;
-static int REG_BLOCK_SIZE;
-static int NURSERY_SIZE;
+//Those that `gc_config` also covers are only defaults, see `policy_t`.
+static int MAX_HEAP_SIZE; //bytes of tenured data, zero for no limit
+static int REG_BLOCK_SIZE; //must be a multiple of 64
+static int REG_SPARE_BLOCKS;
+static int NURSERY_SIZE; //to start with
+static int MIN_NURSERY_SIZE; //must be over `SKIP_NURSERY_THRESHOLD`
+static int MAX_NURSERY_SIZE; //must be a power of two, and a multiple of `TENURE_PAGE_SIZE`
+static int NURSERY_GROW_SURVIVAL; //percent of the young generation surviving a minor collection that grows the nursery
+static int NURSERY_SHRINK_SURVIVAL; //and that shrinks it
+static int SURVIVOR_SIZE;
+static int TENURE_AGE;
 static int SKIP_NURSERY_THRESHOLD;
+static int LARGE_OBJECT_SIZE; //objects at least this big get a mapping of their own
+static int LARGE_HUGE_SIZE; //mappings at least this big ask for huge pages
+static int LARGE_SPARE_REGIONS;
+static int MAJOR_TRIGGER_BYTES; //tenured since the last major collection, before the next is due, at the least
+static int HEAP_GROWTH_PERCENT; //of the live heap that may be tenured before a major collection is due
 static int SUGGESTED_QUEUE_SIZE;
+static int MARK_CHUNK_SIZE; //gateways per chunk of a mark stack
+static int MARK_SPARE_CHUNKS;
+static int TENURE_PAGE_SIZE;
+static int TENURE_SPARE_PAGES;
+static int COMPACT_PERCENT; //tenure pages less full than this are emptied by compaction
+static int WEAK_CHUNK_SIZE;
+static int ROOT_CHUNK_SIZE; //handles per chunk, see `gc_add_root`
+static int SHADOW_STACK_SIZE; //slots in each thread's shadow stack
+static int HEAP_RESERVE_MB; //of addresses reserved by each thread, see `reserve_t`
 
 
+/**
+ * Options for `gc_init`, see the public header.
+ */
+typedef struct gc_config {
+    int marker_threads;
+    int step_budget;
+    int compact;
+    int profile;
+    size_t max_heap_size;
+    size_t nursery_size;
+    int fixed_nursery;
+    int heap_growth;
+} gc_config;
+
 /**
  * Ready this thread for using the garbage collection system.
  * Any use of these gc functions results in undefined behavior if `gc_init` hasn't yet been called.
  */
-void gc_init();
+void gc_init(const gc_config*);
 
 /**
  * Teardown the garbage collection system in this thread, including running finalizers on all living objects.
@@ -44,12 +79,37 @@ typedef struct registry_t registry_t;
  */
 static inline registry_t* getRegistry();
 
+/**
+ * Ready an empty registry.
+ */
+static void setup_registry();
+
 /**
  * During gc, the gateway registry should be cleaned up as well.
  * This is because the gcobj handles must be left in place until object death, but many objects are expected to die.
  */
 static void clean_registry(int stage);
 
+/**
+ * Ready the registry to be swept a bit at a time after a major collection.
+ */
+static void begin_sweep();
+
+/**
+ * Sweep some of what a major collection left unswept, returning any unused budget.
+ */
+static size_t sweep_some(size_t budget);
+
+/**
+ * Count the registry's blocks, and the gateways in use across them.
+ */
+static void count_registry(size_t* blocks, size_t* gateways);
+
+/**
+ * Finalize every object still in the registry, and give all its memory back to the system.
+ */
+static void teardown_registry();
+
 
 /**
  * Data structures needed by the tracer.
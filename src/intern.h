@@ -0,0 +1,47 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+
+/**
+ * Promise that a gc-managed object will never change again, so that once tenured, it may share its data with any
+ * other such object holding the same bytes.
+ * The gcobj itself stays distinct, and is returned no longer fresh (see `mut_gcobj`); changing it in place is an error.
+ * Objects with a finalizer, or too big for a tenure page, keep data of their own all the same.
+ */
+gcobj intern_gcobj(gcobj);
+
+
+/**
+ * Tenured data shared by interned objects, and how many gateways reference it.
+ */
+typedef struct intern_entry intern_entry;
+
+/**
+ * Per-thread table of tenured data shared by interned objects.
+ */
+typedef struct intern_table_t intern_table_t;
+
+/**
+ * Get a handle to this thread's intern table.
+ */
+static inline intern_table_t* getInterns();
+
+/**
+ * Find tenured data equal to the given data, or tenure a copy of it if there's none, and take a reference to it.
+ * Set `shared` to whether it was found.
+ * If the system is out of memory, then return `NULL`.
+ */
+static void* intern_data(const void* data, size_t bytes, bool* shared);
+
+/**
+ * Drop a reference taken by `intern_data`, freeing the data along with the last one.
+ */
+static void intern_release(void* data, size_t bytes);
+
+/**
+ * Forget all interned data, which must already have been released.
+ */
+static void intern_teardown();
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef LARGE_H
+#define LARGE_H
+
+
+/**
+ * Allocate a buffer in the large object space, to be filled in and handed to `to_gcobj`,
+ * which then adopts it as it is, instead of taking it as memory from malloc.
+ * If the system is out of memory, then return `NULL`.
+ */
+void* gc_alloc_large(size_t bytes);
+
+/**
+ * Give back a buffer from `gc_alloc_large` that was never handed to `to_gcobj`.
+ */
+void gc_free_large(void*);
+
+
+/**
+ * A mapping holding a single large object.
+ */
+typedef struct large_region large_region;
+
+/**
+ * Per-thread collection of large object mappings.
+ */
+typedef struct large_space_t large_space_t;
+
+/**
+ * Get a handle to this thread's large object space.
+ */
+static inline large_space_t* getLargeSpace();
+
+/**
+ * Allocate an object of at least `LARGE_OBJECT_SIZE` bytes in a mapping of its own.
+ * If the system is out of memory, then return `NULL`.
+ */
+static void* large_alloc(size_t bytes);
+
+/**
+ * Release an object allocated by `large_alloc`, or adopted by `large_adopt`.
+ */
+static void large_free(void* data);
+
+/**
+ * If `data` is a buffer from `gc_alloc_large` not yet handed to `to_gcobj`, take it into the large object space
+ * as if it came from `large_alloc`, and return whether it was.
+ */
+static bool large_adopt(void* data);
+
+/**
+ * Give all large object mappings back to the system, regardless of what they hold.
+ */
+static void large_teardown();
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,47 @@
+#ifndef MARKERS_H
+#define MARKERS_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+
+/**
+ * A thread taking part in parallel marking, along with its deque of gateways waiting to be traced.
+ * Each marker pushes and pops at one end of its own deque, and steals from the other end of others' when it runs dry.
+ */
+typedef struct marker_t marker_t;
+
+/**
+ * The markers of one thread's gc system: the owning thread itself, plus a pool of helper threads.
+ */
+typedef struct marker_pool marker_pool;
+
+/**
+ * Get the marker the calling thread is marking for, or `NULL` outside of parallel marking.
+ */
+static inline marker_t* getMarker();
+
+/**
+ * Start helper threads so that major collections mark with `threads` threads in total.
+ * Return `NULL` if there's no call for parallel marking.
+ */
+static marker_pool* start_markers(int threads);
+
+/**
+ * Stop and join all the helper threads.
+ */
+static void stop_markers(marker_pool*);
+
+/**
+ * Mark a gateway on behalf of a marker, see `gc_mark`.
+ */
+static inline void mark_in_parallel(marker_t*, gcobj);
+
+/**
+ * Perform a major trace using all markers in the pool.
+ * Roots are traced by the calling thread, then everyone traces until there's nothing left.
+ */
+static void trace_in_parallel(marker_pool*);
+
+
+#endif
\ No newline at end of file
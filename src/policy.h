@@ -0,0 +1,47 @@
+#ifndef POLICY_H
+#define POLICY_H
+
+
+/**
+ * Decides when collections happen, and how big the nursery is.
+ */
+typedef struct policy_t policy_t;
+
+/**
+ * Get a handle to this thread's policy.
+ */
+static inline policy_t* getPolicy();
+
+/**
+ * Ready this thread's policy, according to the configuration.
+ */
+static void setup_policy(const gc_config*);
+
+/**
+ * How big the nursery starts out, according to the configuration.
+ */
+static size_t initial_nursery_size(const gc_config*);
+
+/**
+ * Check that an allocation of `bytes` fits under the heap limit.
+ * If it doesn't, run a full major collection first, and fail only if there still isn't room.
+ */
+static inline bool make_room(size_t bytes);
+
+/**
+ * Whether enough has been tenured since the last major collection for the next one to start.
+ */
+static inline bool major_due();
+
+/**
+ * Once a minor collection has emptied the nursery, resize it according to how much of what it found survived.
+ */
+static void adapt_nursery(size_t young, size_t survived);
+
+/**
+ * Once a major collection's sweep is done, take what's left as the live heap, and plan the next collection from it.
+ */
+static void plan_major();
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,53 @@
+#ifndef RESERVE_H
+#define RESERVE_H
+
+
+/**
+ * A range of addresses reserved by each thread, holding its nursery, survivor spaces and tenure pages.
+ */
+typedef struct reserve_t reserve_t;
+
+/**
+ * Get a handle to this thread's reserved range.
+ */
+static inline reserve_t* getReserve();
+
+/**
+ * Reserve this thread's range of addresses, before anything is laid out in it.
+ */
+static void setup_reserve();
+
+/**
+ * Give this thread's whole range back to the system, regardless of what it holds.
+ */
+static void teardown_reserve();
+
+/**
+ * Where the nursery goes: an area of `MAX_NURSERY_SIZE` bytes, aligned to its size.
+ */
+static byte* reserved_nursery();
+
+/**
+ * Where the survivor spaces go: an area of `2*SURVIVOR_SIZE` bytes.
+ */
+static byte* reserved_survivors();
+
+/**
+ * Give the memory behind the whole pages between `start` and `end` back to the system, keeping their addresses.
+ * They read as zero once written to again.
+ */
+static void give_back(void* start, void* end);
+
+/**
+ * Hand out a tenure page from the range, aligned to its size.
+ * If the range is used up, then return `NULL`.
+ */
+static void* reserve_page();
+
+/**
+ * Take back a tenure page, and return whether it came from `reserve_page`.
+ */
+static bool release_page(void* page);
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,98 @@
+#ifndef SHARE_H
+#define SHARE_H
+
+
+/**
+ * A thread's gc system, as seen from other threads, so that they can send it objects.
+ */
+typedef struct gc_heap gc_heap;
+
+/**
+ * Get this thread's heap, to hand to threads that will send objects here.
+ */
+gc_heap* gc_this_heap();
+
+/**
+ * Hand the graph of objects reachable from `root` to another thread's heap, without copying any of it.
+ * The objects stay where they are, and the other heap holds on to them until it finds them dead.
+ * From now on, every object in the graph must be treated as immutable, by both threads:
+ * no `set_gcobj` or `gc_touch`, and `mut_gcobj` always makes a copy.
+ * The sending thread must not call `gc_finish` while the graph may still be in use elsewhere.
+ */
+void gc_send(gc_heap* to, gcobj root);
+
+/**
+ * Take the next object graph sent to this thread, or `NULL` if nothing has arrived.
+ * This is a safe point: graphs sent here only become part of this heap during a call to `gc_receive`.
+ */
+gcobj gc_receive();
+
+
+/**
+ * Per-thread bookkeeping for sending objects to, and holding objects from, other heaps.
+ */
+typedef struct share_t share_t;
+
+/**
+ * Get a handle to this thread's sharing state.
+ */
+static inline share_t* getShare();
+
+/**
+ * Get this thread's heap, as others see it.
+ */
+static inline gc_heap* getHeap();
+
+/**
+ * Ready this thread's heap to send and receive.
+ */
+static void setup_share();
+
+/**
+ * Deal with whatever other heaps have posted here since last time.
+ * Done at every safe point.
+ */
+static void poll_heap();
+
+/**
+ * Mark a gateway that isn't this heap's own to mark, because it's foreign or being sent, see `gc_mark`.
+ */
+static void mark_shared(gcobj);
+
+/**
+ * As `mark_shared`, but on behalf of a parallel marker; return whether the gateway was newly marked.
+ */
+static bool claim_foreign(share_t*, gcobj);
+
+/**
+ * Whether the current collection will leave a foreign gateway alive.
+ */
+static bool foreign_survives(gcobj);
+
+/**
+ * As `shade`, for a foreign gateway.
+ */
+static void shade_foreign(gcobj);
+
+/**
+ * Pin or unpin a foreign gateway, see `pin_gcobj`; pins on foreign gateways are only kept on this side.
+ */
+static void pin_foreign(gcobj, int by);
+
+/**
+ * Once a major collection is done marking, hand any foreign gateways it found dead back to their heaps.
+ */
+static void release_foreign();
+
+/**
+ * Mark the frozen gateways in graphs waiting for `gc_receive`, or still in the inbox, for a collection of the frozen heap.
+ */
+static void mark_delivered();
+
+/**
+ * Hand back everything this heap holds from other heaps, and stop receiving.
+ */
+static void teardown_share();
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,155 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <time.h>
+
+
+/**
+ * Which kind of collection a `gc_event` describes.
+ */
+typedef enum gc_event_kind {
+    GC_MINOR_EVENT,      //a minor collection
+    GC_MAJOR_EVENT,      //a major collection done all at once, apart from the minor collection it starts with
+    GC_INCREMENTAL_EVENT //an incremental major collection, reported once its sweep is done
+} gc_event_kind;
+
+/**
+ * What happened during a single collection, see `gc_on_event`.
+ * Times are in nanoseconds, and are only measured when profiling (see `gc_config`); otherwise they're zero.
+ */
+typedef struct gc_event {
+    int kind;               //see `gc_event_kind`
+    uint64_t pause_ns;      //from start to end, or for incremental collections, the longest step
+    uint64_t mark_ns;
+    uint64_t sweep_ns;      //including finalization
+    uint64_t finalize_ns;   //running finalizers
+    size_t allocated_bytes; //since the previous collection
+    size_t promoted_bytes;  //tenured during the collection
+    size_t young_bytes;     //in the nursery and survivor space, for minor collections
+    size_t survived_bytes;  //of those, found alive
+    double survival_rate;   //`survived_bytes/young_bytes`, or zero if there were none
+    size_t gateways;        //in use afterwards
+    size_t blocks;          //of the gateway registry, afterwards
+    size_t tenured_bytes;   //of data outside the nursery and survivor spaces, afterwards
+} gc_event;
+
+/**
+ * Running totals for this thread's heap, see `gc_get_stats`.
+ * Times are only measured when profiling, as for `gc_event`.
+ */
+typedef struct gc_stats {
+    size_t minor_collections;
+    size_t major_collections; //incremental or not
+    uint64_t pause_ns;        //over all collections done all at once, and all incremental steps
+    uint64_t max_pause_ns;
+    uint64_t mark_ns;
+    uint64_t sweep_ns;        //including finalization, and sweeping left for later by major collections
+    uint64_t finalize_ns;
+    size_t allocated_bytes;
+    size_t promoted_bytes;
+    size_t interned_bytes;    //promoted, but found equal to interned data already tenured, so shared
+    size_t young_bytes;       //over all minor collections, so the survival rate is `survived_bytes/young_bytes`
+    size_t survived_bytes;
+    //current
+    size_t gateways;
+    size_t blocks;
+    size_t tenured_bytes;
+} gc_stats;
+
+/**
+ * Get the statistics of this thread's heap so far.
+ */
+void gc_get_stats(gc_stats*);
+
+/**
+ * Have `f` called with each collection's `gc_event`, or stop if `f` is `NULL`.
+ * It's called at the end of the collection, so it must not use the gc system.
+ */
+void gc_on_event(void (*f)(const gc_event*, void* data), void* data);
+
+
+/**
+ * Per-thread statistics and event reporting.
+ */
+typedef struct stats_t stats_t;
+
+/**
+ * Get a handle to this thread's statistics.
+ */
+static inline stats_t* getStats();
+
+/**
+ * A copy of the running totals, to make an event from later.
+ */
+static inline gc_stats stats_snapshot();
+
+/**
+ * How much object data is outside the young generation right now, see `gc_stats.tenured_bytes`.
+ */
+static inline size_t tenured_now();
+
+/**
+ * The time in nanoseconds, if profiling, otherwise zero.
+ */
+static inline uint64_t stats_clock();
+
+/**
+ * Count the time since `start` as taken by a finalizer.
+ */
+static inline void note_finalized(uint64_t start);
+
+/**
+ * Count data of newly allocated objects.
+ */
+static inline void note_allocated(size_t bytes);
+
+/**
+ * Count data of objects born outside the young generation.
+ */
+static inline void note_tenured_bytes(size_t bytes);
+
+/**
+ * Count data of objects just moved out of the young generation.
+ */
+static inline void note_promoted(size_t bytes);
+
+/**
+ * Count data of objects just moved out of the young generation by sharing data already tenured.
+ */
+static inline void note_interned(size_t bytes);
+
+/**
+ * Count data outside the young generation that has just been freed.
+ */
+static inline void note_freed_bytes(size_t bytes);
+
+/**
+ * Count what a minor collection found in the young generation.
+ */
+static inline void note_young(size_t young, size_t survived);
+
+/**
+ * Wrap up a collection done all at once: count it, and report it to any event callback.
+ * Pass the times it started and finished marking, and the totals as they were when it started.
+ */
+static void note_collection(gc_event_kind, uint64_t start, uint64_t marked, const gc_stats* before);
+
+/**
+ * Note that an incremental major collection is starting.
+ */
+static void begin_incremental_stats();
+
+/**
+ * Wrap up a step of an incremental collection, or of a sweep left by any major collection.
+ * Pass the times it started and finished marking, and whether it finished the collection.
+ * Steps are counted in the totals, and make up the event of an incremental collection, reported once it's done.
+ */
+static void note_step(uint64_t start, uint64_t marked, bool finished);
+
+/**
+ * Ready this thread's statistics, according to the configuration.
+ */
+static void setup_stats(const gc_config*);
+
+
+#endif
\ No newline at end of file
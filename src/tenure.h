@@ -0,0 +1,71 @@
+#ifndef TENURE_H
+#define TENURE_H
+
+
+/**
+ * Tenured objects small enough to have come through the nursery are kept in pages of same-sized cells.
+ * Each page serves a single size class, so promotion is a bump (or a free-list pop) instead of a malloc,
+ * and a page whose cells have all died is reclaimed as a whole.
+ */
+typedef struct tenure_page tenure_page;
+
+/**
+ * The largest object that tenure pages will hold; anything bigger is left to malloc.
+ */
+#define TENURE_MAX_CELL 1024
+
+/**
+ * Per-thread collection of tenure pages, sorted by size class.
+ */
+typedef struct tenure_t tenure_t;
+
+/**
+ * Get a handle to this thread's tenure pages.
+ */
+static inline tenure_t* getTenure();
+
+/**
+ * Allocate a cell in tenure big enough for `bytes`.
+ * If the system is out of memory, then return `NULL`.
+ */
+static void* tenure_alloc(size_t bytes);
+
+/**
+ * Return a cell allocated by `tenure_alloc`.
+ * When this leaves its page empty, the page is recycled.
+ */
+static void tenure_free(void* data);
+
+/**
+ * Give all tenure pages back to the system, regardless of what they hold.
+ */
+static void tenure_teardown();
+
+/**
+ * Count a cell as found alive by the current major collection.
+ */
+static inline void tenure_mark(const void* data);
+
+/**
+ * Once a major collection is done marking, pick out the sparse pages to be emptied by moving their cells elsewhere.
+ * Does nothing unless compaction is turned on.
+ */
+static void select_evacuees();
+
+/**
+ * Whether compaction has any pages to empty.
+ */
+static inline bool tenure_evacuating();
+
+/**
+ * Move a cell out of its page if the page is being emptied, returning where it now lives.
+ */
+static inline void* tenure_evacuate(void* data);
+
+/**
+ * Put pages that couldn't be completely emptied (because of pinned cells) back into use.
+ */
+static void end_evacuation();
+
+
+#endif
\ No newline at end of file
@@ -7,6 +7,13 @@
  */
 void gc_mark(gcobj);
 
+/**
+ * Write barrier: record that a gc-managed object has been changed in place.
+ * Until the next few minor collections are done, the object is traced as if it were a root.
+ * This is only needed when changing objects other than through `set_gcobj`.
+ */
+void gc_touch(gcobj);
+
 /**
  * Add an object (with tracer function) to the tracer as a root object.
  */
@@ -14,14 +21,94 @@ void gc_root(void*, tracer_t);
 
 /**
  * Remove an object from the list of root objects.
+ * This searches the roots, so `gc_add_root` suits roots that come and go often.
  */
 void gc_unroot(void*);
 
+/**
+ * Handle on a root added by `gc_add_root`.
+ */
+typedef struct gc_handle gc_handle;
+
+/**
+ * As `gc_root`, but return a handle that removes the root in constant time, see `gc_drop_root`.
+ */
+gc_handle* gc_add_root(void*, tracer_t);
+
+/**
+ * Remove a root added by `gc_add_root`; the handle is no longer valid afterwards.
+ */
+void gc_drop_root(gc_handle*);
+
+/**
+ * Push a frame of `n` root slots onto this thread's shadow stack, and return the first slot.
+ * The slots start out `NULL`; whatever is stored in them stays alive until the frame is popped.
+ */
+gcobj* gc_push_frame(size_t n);
+
+/**
+ * Pop a frame pushed by `gc_push_frame`, along with any pushed after it.
+ */
+void gc_pop_frame(gcobj* frame);
+
+/**
+ * Perform a major garbage collection in this thread.
+ * Most dead objects are only finalized and freed afterwards, as new gateways need their room, or by `gc_step`.
+ */
+void gc_run();
+
+/**
+ * Do up to about `budget` gateways' worth of an incremental major collection, starting one if none is in progress.
+ * A major collection still being swept counts as in progress.
+ * Return nonzero once the collection is complete.
+ */
+int gc_step(size_t budget);
+
+/**
+ * Trace the roots and the shadow stack.
+ */
+static void trace_roots();
+
 /**
  * Perform a trace.
  * Pass `0` in stage for minor, `1` for major.
+ * Incremental major collections use stage `2`, but don't go through here, nor does `gc_send`, which uses stage `3`,
+ * nor the frozen heap, which uses stage `4`.
  */
 static void trace(int stage);
 
+/**
+ * Collect the young generation, moving survivors into tenure.
+ */
+static void minor_gc();
+
+/**
+ * Collect everything.
+ */
+static void major_gc();
+
+/**
+ * Do the share of `allocations` allocations of any major collection, starting one if it's due (see `major_due`).
+ * With no step budget, the whole collection is done at once.
+ */
+static inline void allocation_step(size_t allocations);
+
+/**
+ * Let any incremental major collection know that a gateway has just left the young generation,
+ * counting `bytes` as newly tenured.
+ */
+static void note_tenured(gcobj, size_t bytes);
+
+/**
+ * While an incremental major collection is marking, mark a tenured gateway grey, unless it's already marked.
+ * For gateways the mutator gets hold of without going through anything marking would see.
+ */
+static void shade(gcobj);
+
+/**
+ * Let the major collection being swept know that the sweep is over, whoever finished it.
+ */
+static void end_sweep();
+
 
 #endif
\ No newline at end of file
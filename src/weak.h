@@ -0,0 +1,62 @@
+#ifndef WEAK_H
+#define WEAK_H
+
+
+/**
+ * A reference to a gc-managed object that doesn't keep it alive.
+ * Weak references belong to the user, and stay valid (if cleared) after their target dies, until `free_weak`.
+ */
+typedef struct gc_weak gc_weak;
+
+/**
+ * Make a weak reference to a gc-managed object.
+ */
+gc_weak* new_weak(gcobj target);
+
+/**
+ * Make an ephemeron: a weak reference to `key` that also holds on to `value`, but only for as long as `key` is alive.
+ * A value pointing back at its own key doesn't keep the key alive.
+ */
+gc_weak* new_ephemeron(gcobj key, gcobj value);
+
+/**
+ * Get the target of a weak reference (the key of an ephemeron), or `NULL` once it's been collected.
+ */
+gcobj weak_target(gc_weak*);
+
+/**
+ * Get the value of an ephemeron, or `NULL` once its key has been collected, or if it's a plain weak reference.
+ */
+gcobj weak_value(gc_weak*);
+
+/**
+ * Give a weak reference back, whether or not it's been cleared.
+ */
+void free_weak(gc_weak*);
+
+
+/**
+ * Per-thread table of all weak references.
+ */
+typedef struct weak_table_t weak_table_t;
+
+/**
+ * Get a handle to this thread's weak references.
+ */
+static inline weak_table_t* getWeakTable();
+
+/**
+ * Once marking is otherwise done, keep the values of ephemerons with live keys alive,
+ * then clear every weak reference whose target is dead, all in one pass over the table,
+ * or for minor collections, over just the entries that may still refer to something young.
+ * Must come before any of the dead are swept.
+ */
+static void settle_weak();
+
+/**
+ * Give the memory of all weak references back to the system.
+ */
+static void weak_teardown();
+
+
+#endif
\ No newline at end of file
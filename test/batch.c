@@ -0,0 +1,66 @@
+/*
+ * Objects created in a batch need no rooting for one another's creation, since any collection happens when the batch
+ * is opened, and none while it's open.
+ */
+#include "test.h"
+
+#define LENGTH 5000
+#define LIMIT (1024*1024)
+
+typedef struct cell {
+    gcobj next;
+    long val;
+} cell;
+
+static const size_t cell_offsets[] = { offsetof(cell, next) };
+static const gc_layout cell_layout = { .stride = 0, .count = 1, .offsets = cell_offsets };
+
+static size_t minors() {
+    gc_stats stats;
+    gc_get_stats(&stats);
+    return stats.minor_collections;
+}
+
+int main() {
+    gc_config config = { .max_heap_size = LIMIT };
+    gc_init(&config);
+    gcobj* held = gc_push_frame(1);
+    //Leave the nursery almost full, so that the batch needs a minor collection to fit.
+    nursery_t* nursery = getNursery();
+    long filler[8] = {0};
+    while (nursery->top + 4*sizeof filler < nursery->end) new_gcobj(filler, sizeof filler, NULL, NULL);
+    size_t before = minors();
+    check(gc_begin_batch(LENGTH + 1, LENGTH*sizeof(cell) + LARGE_OBJECT_SIZE));
+    check(minors() == before + 1);
+    size_t blocks = getRegistry()->block_count;
+    //Nothing built here is rooted until the batch is over.
+    gcobj list = NULL;
+    for (long k = 0; k < LENGTH; ++k) {
+        cell c = { list, k };
+        list = batch_gcobj_layout(&c, sizeof c, &cell_layout, NULL);
+        check(space_of(list) == NURSERY_SPACE);
+    }
+    byte* big = malloc(LARGE_OBJECT_SIZE);
+    check(big);
+    memset(big, 1, LARGE_OBJECT_SIZE);
+    gcobj x = batch_gcobj(big, LARGE_OBJECT_SIZE, NULL, NULL);
+    check(space_of(x) == LARGE_SPACE && ((const byte*)gate_data(x))[LARGE_OBJECT_SIZE - 1] == 1);
+    gc_end_batch();
+    check(minors() == before + 1);
+    check(getRegistry()->block_count == blocks);
+    held[0] = list;
+    //The list survives collections once rooted.
+    minor_gc();
+    collect_all();
+    long k = LENGTH;
+    for (gcobj at = held[0]; at; at = ((const cell*)gate_data(at))->next) check(((const cell*)gate_data(at))->val == --k);
+    check(k == 0);
+    //A batch that can't fit under the heap limit isn't opened.
+    check(!gc_begin_batch(1, 2*LIMIT));
+    check(gc_begin_batch(1, sizeof(cell)));
+    gc_end_batch();
+    free(big);
+    gc_pop_frame(held);
+    gc_finish();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+/*
+ * Churning a persistent list through incremental collections keeps every registry block on the list matching
+ * how full it is, keeps only a few empty blocks spare, and never loses a version still held.
+ */
+#include "test.h"
+
+#define OPERATIONS 2000000
+#define VERSIONS 64
+
+typedef struct cell {
+    gcobj next;
+    long val;
+} cell;
+
+static const size_t cell_offsets[] = { offsetof(cell, next) };
+static const gc_layout cell_layout = { .stride = 0, .count = 1, .offsets = cell_offsets };
+
+static unsigned long seed = 1;
+
+static unsigned long next_random() {
+    seed = seed*6364136223846793005UL + 1442695040888963407UL;
+    return seed >> 33;
+}
+
+static long length_of(gcobj x) {
+    long n = 0;
+    for (; x; x = ((const cell*)gate_data(x))->next) ++n;
+    return n;
+}
+
+/**
+ * Check that each block is filed where it belongs, and that the running counts agree.
+ */
+static void check_registry() {
+    registry_t* registry = getRegistry();
+    size_t blocks = 0, gateways = 0;
+    int spares = 0;
+    for (int k = 0; k < NUM_BLOCK_LISTS; ++k) {
+        for (reg_node* node = registry->blocks[k]; node; node = node->next) {
+            check(node->list == k);
+            check(!node->next || node->next->prev == node);
+            check(k != FULL_BLOCKS || node->filled == (uint)REG_BLOCK_SIZE);
+            check(k != PARTIAL_BLOCKS || (node->filled && node->filled < (uint)REG_BLOCK_SIZE));
+            check(k != EMPTY_BLOCKS || !node->filled);
+            spares += k == EMPTY_BLOCKS;
+            blocks++;
+            gateways += node->filled;
+        }
+    }
+    check(spares == registry->spare_count && spares <= REG_SPARE_BLOCKS);
+    check(blocks == registry->block_count);
+    check(gateways == registry->gateway_count);
+}
+
+static long lengths[VERSIONS];
+
+int main() {
+    gc_config config = { .step_budget = 256 };
+    gc_init(&config);
+    gcobj* versions = gc_push_frame(VERSIONS + 1);
+    gcobj* list = &versions[VERSIONS];
+    long length = 0;
+    for (long k = 0; k < OPERATIONS; ++k) {
+        //Push half the time, and pop otherwise, so the list wanders in length and dies a little at a time.
+        if (next_random() % 2 || !*list) {
+            cell c = { *list, k };
+            *list = new_gcobj_layout(&c, sizeof c, &cell_layout, NULL);
+            length++;
+        }
+        else {
+            *list = ((const cell*)gate_data(*list))->next;
+            length--;
+        }
+        if (!(k % 16)) {
+            versions[k/16 % VERSIONS] = *list;
+            lengths[k/16 % VERSIONS] = length;
+        }
+        if (!(k % 100000)) check_registry();
+        //Start an incremental major collection now and then, which allocation then carries along.
+        if (!(k % 250000)) gc_step(1);
+    }
+    collect_all();
+    check_registry();
+    for (int v = 0; v < VERSIONS; ++v) check(length_of(versions[v]) == lengths[v]);
+    //Once nothing is held, everything goes, and only the spare blocks stay.
+    gc_pop_frame(versions);
+    collect_all();
+    check_registry();
+    check(!getRegistry()->gateway_count);
+    check(getRegistry()->block_count <= (size_t)REG_SPARE_BLOCKS);
+    gc_finish();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+/*
+ * Objects reachable from the roots survive minor and major collections with their data intact,
+ * and everything else is finalized exactly once, as is whatever is left when the collector is torn down.
+ */
+#include "test.h"
+
+#define LENGTH 1000
+#define GARBAGE 5000
+
+typedef struct cell {
+    gcobj next;
+    long value;
+} cell;
+
+static int dead;
+
+static void count_dead(void* obj) {
+    (void)obj;
+    ++dead;
+}
+
+static void trace_cell(const void* obj) {
+    const cell* c = obj;
+    if (c->next) gc_mark(c->next);
+}
+
+static void trace_slot(const void* slot) {
+    gcobj x = *(const gcobj*)slot;
+    if (x) gc_mark(x);
+}
+
+static void get_value(const void* obj, void* res) {
+    *(long*)res = ((const cell*)obj)->value;
+}
+
+/**
+ * Check that the list holds every value from `length - 1` down to zero.
+ */
+static void check_list(gcobj x, long length) {
+    for (long k = length; k-- > 0; x = ((const cell*)gate_data(x))->next) {
+        long value = -1;
+        ask_gcobj(x, get_value, &value);
+        check(value == k);
+    }
+    check(!x);
+}
+
+int main() {
+    gc_init(NULL);
+    gcobj head = NULL;
+    gc_root(&head, trace_slot);
+    //Enough garbage in between to fill the nursery a few times over.
+    for (long k = 0; k < LENGTH; ++k) {
+        cell c = { head, k };
+        head = new_gcobj(&c, sizeof c, trace_cell, count_dead);
+        for (int g = 0; g < GARBAGE/LENGTH; ++g) new_gcobj(&c, sizeof c, trace_cell, count_dead);
+    }
+    minor_gc();
+    check(dead == GARBAGE);
+    check_list(head, LENGTH);
+    collect_all();
+    check(dead == GARBAGE);
+    check_list(head, LENGTH);
+    //Dropping the head takes the whole list with it.
+    head = NULL;
+    collect_all();
+    check(dead == GARBAGE + LENGTH);
+    //Whatever is still alive at the end is finalized too.
+    cell c = { NULL, 0 };
+    head = new_gcobj(&c, sizeof c, trace_cell, count_dead);
+    gc_unroot(&head);
+    gc_finish();
+    check(dead == GARBAGE + LENGTH + 1);
+    return 0;
+}
\ No newline at end of file
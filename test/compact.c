@@ -0,0 +1,61 @@
+/*
+ * Compacting major collections move live objects out of sparse tenure pages, with their data intact,
+ * give the emptied pages back, and leave pinned objects where they are.
+ */
+#include "test.h"
+
+#define COUNT 26000
+#define KEEP 13
+
+typedef struct cell {
+    long value;
+    long padding[3];
+} cell;
+
+static gcobj objs[COUNT];
+static void* was_at[COUNT];
+
+static void trace_objs(const void* obj) {
+    const gcobj* at = obj;
+    for (int k = 0; k < COUNT; ++k) if (at[k]) gc_mark(at[k]);
+}
+
+static int count_pages(uint size_class) {
+    int pages = 0;
+    for (tenure_page* page = getTenure()->partial[size_class]; page; page = page->next) ++pages;
+    for (tenure_page* page = getTenure()->full[size_class]; page; page = page->next) ++pages;
+    return pages;
+}
+
+int main() {
+    gc_config config = { .compact = 1 };
+    gc_init(&config);
+    gc_root(objs, trace_objs);
+    for (int k = 0; k < COUNT; ++k) {
+        cell c = { .value = k };
+        objs[k] = new_gcobj(&c, sizeof c, NULL, NULL);
+    }
+    for (int k = 0; k < TENURE_AGE; ++k) minor_gc();
+    uint size_class = size_class_of(sizeof(cell));
+    int before = count_pages(size_class);
+    int per_page = TENURE_PAGE_SIZE/size_class_cell(size_class);
+    check(before >= COUNT/per_page);
+    //Keep one in every few, and pin one of those, so that its page can't be emptied.
+    for (int k = 0; k < COUNT; ++k) if (k % KEEP) objs[k] = NULL;
+    gcobj pinned = objs[KEEP];
+    void* pinned_at = pinned->data;
+    pin_gcobj(pinned);
+    for (int k = 0; k < COUNT; k += KEEP) was_at[k] = objs[k]->data;
+    collect_all();
+    int after = count_pages(size_class);
+    check(after <= (COUNT/KEEP)/per_page + 2 && after < before);
+    int moved = 0;
+    for (int k = 0; k < COUNT; k += KEEP) {
+        check(space_of(objs[k]) == TENURE_SPACE && ((const cell*)gate_data(objs[k]))->value == k);
+        if (objs[k]->data != was_at[k]) ++moved;
+    }
+    check(moved && pinned->data == pinned_at);
+    unpin_gcobj(pinned);
+    gc_finish();
+    return 0;
+}
\ No newline at end of file
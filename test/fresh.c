@@ -0,0 +1,53 @@
+/*
+ * `mut_gcobj` only updates an object in place once its holder has claimed it through `own_gcobj`,
+ * so that sharing a gcobj without a soft copy keeps the baseline's persistent updates.
+ */
+#include "test.h"
+
+static void bump(void* obj) {
+    ++*(long*)obj;
+}
+
+static long value(gcobj x) {
+    return *(const long*)gate_data(x);
+}
+
+static gcobj held[3];
+
+static void trace_held(const void* obj) {
+    const gcobj* at = obj;
+    for (int k = 0; k < 3; ++k) if (at[k]) gc_mark(at[k]);
+}
+
+int main() {
+    gc_init(NULL);
+    gc_root(held, trace_held);
+    long zero[2] = {0};
+    //Held in two places, with no soft copy in between.
+    held[0] = new_gcobj(zero, sizeof zero, NULL, NULL);
+    held[1] = held[0];
+    held[2] = mut_gcobj(held[1], bump);
+    check(held[2] != held[0]);
+    check(value(held[0]) == 0);
+    check(value(held[2]) == 1);
+    //Neither is the copy fresh, so updating it again copies it again.
+    gcobj again = mut_gcobj(held[2], bump);
+    check(again != held[2]);
+    check(value(held[2]) == 1);
+    //Once owned, it's updated in place, until it's shared again.
+    held[2] = own_gcobj(again);
+    check(mut_gcobj(held[2], bump) == held[2]);
+    check(value(held[2]) == 3);
+    held[1] = soft_copy_gcobj(held[2]);
+    held[2] = mut_gcobj(held[2], bump);
+    check(held[2] != held[1]);
+    check(value(held[1]) == 3);
+    check(value(held[2]) == 4);
+    //The same goes for objects small enough to be kept in their gateway.
+    held[0] = new_gcobj(zero, sizeof(long), NULL, NULL);
+    held[1] = held[0];
+    check(mut_gcobj(held[1], bump) != held[0]);
+    check(value(held[0]) == 0);
+    gc_finish();
+    return 0;
+}
\ No newline at end of file
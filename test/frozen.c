@@ -0,0 +1,69 @@
+/*
+ * Frozen objects outlive the heap that froze them for as long as something reaches them,
+ * and their finalizers run outside the frozen heap's lock, so may freeze objects of their own.
+ */
+#include "test.h"
+
+#define MANY 4000
+
+typedef struct link {
+    long tag;
+    gcobj next;
+} link;
+
+static const size_t link_offsets[] = { offsetof(link, next) };
+static const gc_layout link_layout = { .stride = 0, .count = 1, .offsets = link_offsets };
+
+static int dead, refrozen;
+
+static void count_dead(void* obj) {
+    (void)obj;
+    ++dead;
+}
+
+static void freeze_again(void* obj) {
+    //Frozen while the collection that found this dead is still finishing up.
+    link l = *(const link*)obj;
+    check(gc_freeze(new_gcobj(&l, sizeof l, NULL, NULL)));
+    ++refrozen;
+}
+
+static gcobj frozen_link(long tag, gcobj next, finalizer_t destroy) {
+    link l = { .tag = tag, .next = next };
+    return gc_freeze(new_gcobj_layout(&l, sizeof l, &link_layout, destroy));
+}
+
+static gcobj held;
+
+static void trace_held(const void* slot) {
+    gcobj x = *(const gcobj*)slot;
+    if (x) gc_mark(x);
+}
+
+int main() {
+    gc_init(NULL);
+    gc_root(&held, trace_held);
+    //More than a block's worth, so freezing has full blocks to get past.
+    for (int k = 0; k < MANY; ++k) frozen_link(k, NULL, count_dead);
+    held = frozen_link(2, frozen_link(1, NULL, count_dead), count_dead);
+    check(gc_freeze(held) == held);
+    frozen_link(0, NULL, freeze_again);
+    //Freezing copies, finalizers and all, so let the unfrozen originals go first.
+    collect_all();
+    dead = refrozen = 0;
+    gc_collect_frozen();
+    check(dead == MANY);
+    check(refrozen == 1);
+    //The chain held by this heap is intact.
+    const link* l = gate_data(held);
+    check(l->tag == 2 && ((const link*)gate_data(l->next))->tag == 1);
+    //Pinned frozen objects stay, even once nothing holds them.
+    pin_gcobj(held);
+    held = NULL;
+    gc_collect_frozen();
+    check(dead == MANY);
+    gc_finish();
+    //Everything left is finalized with the frozen heap.
+    check(dead == MANY + 2);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+/*
+ * An incremental major collection keeps whatever is reachable when it finishes,
+ * even when a pointer is moved into an object it has already traced, or minor collections run in between.
+ */
+#include "test.h"
+
+typedef struct pair {
+    gcobj first, second;
+} pair;
+
+static int dead;
+static bool moved_dead;
+static gcobj moving;
+
+static void count_dead(void* obj) {
+    (void)obj;
+    ++dead;
+}
+
+static void note_moved_dead(void* obj) {
+    (void)obj;
+    moved_dead = true;
+}
+
+static void trace_pair(const void* obj) {
+    const pair* p = obj;
+    if (p->first) gc_mark(p->first);
+    if (p->second) gc_mark(p->second);
+}
+
+static void trace_slot(const void* slot) {
+    gcobj x = *(const gcobj*)slot;
+    if (x) gc_mark(x);
+}
+
+static void take_second(void* obj) {
+    ((pair*)obj)->second = moving;
+}
+
+static void drop_first(void* obj) {
+    ((pair*)obj)->first = NULL;
+}
+
+static void make_old(gcobj* slot) {
+    gc_root(slot, trace_slot);
+    for (int k = 0; k < TENURE_AGE; ++k) minor_gc();
+    gc_unroot(slot);
+}
+
+int main() {
+    gc_init(NULL);
+    //The root holds `a`, which holds `c`, which holds `z`, all tenured.
+    pair p = { NULL, NULL };
+    gcobj z = new_gcobj(&p, sizeof p, NULL, note_moved_dead);
+    make_old(&z);
+    p.first = z;
+    gcobj c = new_gcobj(&p, sizeof p, trace_pair, count_dead);
+    make_old(&c);
+    p.first = c;
+    gcobj a = new_gcobj(&p, sizeof p, trace_pair, count_dead);
+    gc_root(&a, trace_slot);
+    make_old(&a);
+    check(!is_young(a) && !is_young(c) && !is_young(z));
+    //One step marks the roots and traces `a`, leaving it black and `c` grey.
+    check(!gc_step(1));
+    mark_chunk* grey = getTracer()->grey.top;
+    check(getTracer()->phase == MARK_PHASE && grey && grey->len == 1 && !grey->next);
+    //Move `z` from the grey object to the black one, which the barrier greys again.
+    moving = z;
+    set_gcobj(a, take_second);
+    set_gcobj(c, drop_first);
+    moving = c = z = NULL;
+    //Young objects come and go meanwhile, some of them tenured before marking is done.
+    gcobj young = new_gcobj(&p, sizeof p, NULL, count_dead);
+    gc_root(&young, trace_slot);
+    new_gcobj(&p, sizeof p, NULL, count_dead);
+    for (int k = 0; k < TENURE_AGE; ++k) minor_gc();
+    check(dead == 1 && !is_young(young));
+    while (!gc_step(1)) pass;
+    check(getTracer()->phase == IDLE_PHASE);
+    check(!moved_dead && dead == 1);
+    const pair* held = gate_data(a);
+    check(held->second && held->first && !((const pair*)gate_data(held->first))->first);
+    //Once `z` is let go again, the next collection frees it.
+    set_gcobj(a, take_second);
+    while (!gc_step(SIZE_MAX)) pass;
+    check(moved_dead && dead == 1);
+    //Stop-the-world collections still work after incremental ones.
+    gc_unroot(&a);
+    collect_all();
+    check(dead == 3);
+    gc_finish();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+/*
+ * Equal interned objects share their data once tenured, and the shared data is freed once, along with the last of them.
+ * Interned objects can't be changed in place, and trying to fails before anything has changed.
+ */
+#include "test.h"
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+typedef struct triple {
+    long a, b, c;
+} triple;
+
+static atomic_int* changed; //shared with the child processes below
+
+static void change(void* obj) {
+    ((triple*)obj)->c++;
+    atomic_store(changed, 1);
+}
+
+/**
+ * Check that changing an interned object in place aborts, without having changed it first.
+ */
+static void check_refused(gcobj x) {
+    pid_t pid = fork();
+    check(pid >= 0);
+    if (!pid) {
+        //Keep the expected abort quiet.
+        check(freopen("/dev/null", "w", stderr));
+        set_gcobj(x, change);
+        _exit(0);
+    }
+    int status;
+    check(waitpid(pid, &status, 0) == pid);
+    check(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT);
+    check(!atomic_load(changed));
+}
+
+int main() {
+    gc_init(NULL);
+    changed = mmap(NULL, sizeof(atomic_int), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    check(changed != MAP_FAILED);
+    intern_table_t* table = getInterns();
+    gcobj* held = gc_push_frame(3);
+    triple t = { 1, 2, 3 }, u = { 1, 2, 4 };
+    held[0] = intern_gcobj(new_gcobj(&t, sizeof t, NULL, NULL));
+    held[1] = intern_gcobj(new_gcobj(&t, sizeof t, NULL, NULL));
+    held[2] = intern_gcobj(new_gcobj(&u, sizeof u, NULL, NULL));
+    check_refused(held[2]);
+    for (int k = 0; k < 3; ++k) gc_promote(held[k]);
+    //The gcobjs stay distinct, but only differing data is kept twice.
+    check(held[0] != held[1]);
+    check(held[0]->data == held[1]->data);
+    check(held[0]->data != held[2]->data);
+    check(table->len == 2);
+    check(!memcmp(gate_data(held[1]), &t, sizeof t));
+    check_refused(held[1]);
+    //Either one dying leaves the data to the other.
+    held[0] = NULL;
+    collect_all();
+    check(table->len == 2);
+    check(!memcmp(gate_data(held[1]), &t, sizeof t));
+    held[1] = NULL;
+    collect_all();
+    check(table->len == 1);
+    held[2] = NULL;
+    collect_all();
+    check(table->len == 0);
+    gc_pop_frame(held);
+    gc_finish();
+    munmap(changed, sizeof(atomic_int));
+    return 0;
+}
\ No newline at end of file
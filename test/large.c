@@ -0,0 +1,75 @@
+/*
+ * Objects of at least `LARGE_OBJECT_SIZE` bytes get a mapping each, which goes back to the system or onto the spares
+ * when they die, and buffers from `gc_alloc_large` are adopted in place by `to_gcobj`.
+ */
+#include "test.h"
+
+#define COUNT 8
+
+static int dead;
+
+static void count_dead(void* obj) {
+    (void)obj;
+    ++dead;
+}
+
+static int length_of(large_region* list) {
+    int n = 0;
+    for (; list; list = list->next) ++n;
+    return n;
+}
+
+static bool is_region(large_region* list, void* data) {
+    for (; list; list = list->next) if (region_data(list) == data) return true;
+    return false;
+}
+
+int main() {
+    gc_init(NULL);
+    large_space_t* space = getLargeSpace();
+    size_t bytes = LARGE_OBJECT_SIZE;
+    byte* source = malloc(bytes);
+    check(source);
+    //Each large object lands in a mapping of its own, whole.
+    gcobj* held = gc_push_frame(COUNT);
+    for (int k = 0; k < COUNT; ++k) {
+        memset(source, k, bytes);
+        held[k] = new_gcobj(source, bytes, NULL, count_dead);
+        check(space_of(held[k]) == LARGE_SPACE);
+        check(is_region(space->live, held[k]->data));
+    }
+    check(length_of(space->live) == COUNT);
+    collect_all();
+    for (int k = 0; k < COUNT; ++k) {
+        const byte* data = gate_data(held[k]);
+        check(data[0] == k && data[bytes - 1] == k);
+    }
+    //Smaller objects skip the nursery, but stay in malloc.
+    held[0] = new_gcobj(source, bytes - 1, NULL, count_dead);
+    check(space_of(held[0]) == MALLOC_SPACE);
+    //Once they die, a few of their mappings are kept spare, and the next large object reuses one.
+    gc_pop_frame(held);
+    collect_all();
+    check(dead == COUNT + 1);
+    check(!space->live);
+    check(space->spare_count == LARGE_SPARE_REGIONS && length_of(space->spare) == LARGE_SPARE_REGIONS);
+    gcobj x = new_gcobj(source, bytes, NULL, NULL);
+    check(space->spare_count == LARGE_SPARE_REGIONS - 1);
+    check(space->live && region_data(space->live) == x->data);
+    //A buffer from `gc_alloc_large` waits until it's handed over, and is then adopted as it is.
+    byte* buffer = gc_alloc_large(bytes);
+    check(buffer && is_region(space->adopting, buffer));
+    memset(buffer, 7, bytes);
+    x = to_gcobj(buffer, bytes, NULL, NULL);
+    check(x->data == buffer && space_of(x) == LARGE_SPACE);
+    check(!space->adopting && is_region(space->live, buffer));
+    //One never handed over can be given back, and malloc buffers are left to malloc.
+    buffer = gc_alloc_large(bytes);
+    check(buffer);
+    gc_free_large(buffer);
+    check(!space->adopting);
+    x = to_gcobj(source, bytes, NULL, NULL);
+    check(space_of(x) == MALLOC_SPACE);
+    gc_finish();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+/*
+ * Objects traced by a layout keep their children alive through collections, strided or not,
+ * and layouts that find no room in an object leave it untraced instead of stalling the collector.
+ */
+#include "test.h"
+
+#define PAIRS 64
+
+typedef struct node {
+    long tag;
+    gcobj left, right;
+} node;
+
+typedef struct pair {
+    long tag;
+    gcobj child;
+} pair;
+
+static const size_t node_offsets[] = { offsetof(node, left), offsetof(node, right) };
+static const gc_layout node_layout = { .stride = 0, .count = 2, .offsets = node_offsets };
+static const size_t pair_offsets[] = { offsetof(pair, child) };
+static const gc_layout pair_layout = { .stride = sizeof(pair), .count = 1, .offsets = pair_offsets };
+
+static int dead;
+
+static void count_dead(void* obj) {
+    (void)obj;
+    ++dead;
+}
+
+static gcobj leaf(long tag) {
+    long cell[2] = { tag, 0 }; //too big to fit in a gateway
+    return new_gcobj(cell, sizeof cell, NULL, count_dead);
+}
+
+static long tag_of(gcobj x) {
+    return *(const long*)gate_data(x);
+}
+
+static gcobj held[4];
+
+static void trace_held(const void* obj) {
+    const gcobj* at = obj;
+    for (int k = 0; k < 4; ++k) if (at[k]) gc_mark(at[k]);
+}
+
+int main() {
+    gc_init(NULL);
+    gc_root(held, trace_held);
+    node n = { .tag = -1, .left = leaf(1), .right = leaf(2) };
+    held[0] = new_gcobj_layout(&n, sizeof n, &node_layout, NULL);
+    pair pairs[PAIRS];
+    for (int k = 0; k < PAIRS; ++k) pairs[k] = (pair){ .tag = k, .child = leaf(100 + k) };
+    held[1] = new_gcobj_layout(pairs, sizeof pairs, &pair_layout, NULL);
+    //Neither a zero-byte object nor one smaller than its stride has anything to trace.
+    held[2] = new_gcobj_layout(NULL, 0, &node_layout, NULL);
+    held[3] = new_gcobj_layout(&n, sizeof(long), &pair_layout, NULL);
+    leaf(-2);
+    collect_all();
+    collect_all();
+    //Only the unreferenced leaf is gone.
+    check(dead == 1);
+    const node* m = gate_data(held[0]);
+    check(tag_of(m->left) == 1 && tag_of(m->right) == 2);
+    const pair* p = gate_data(held[1]);
+    for (int k = 0; k < PAIRS; ++k) check(p[k].tag == k && tag_of(p[k].child) == 100 + k);
+    //Dropping the strided array takes every one of its children with it.
+    held[1] = NULL;
+    collect_all();
+    check(dead == 1 + PAIRS);
+    gc_finish();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+/*
+ * Buffers handed over through `to_gcobj` count towards the heap limit, the same as data the collector allocates.
+ */
+#include "test.h"
+
+#define LIMIT (4*1024*1024)
+#define CHUNK (64*1024)
+
+static void* buffer(int k) {
+    //Every other one comes from the large object space.
+    void* data = k % 2 ? malloc(CHUNK) : gc_alloc_large(CHUNK);
+    check(data);
+    return data;
+}
+
+int main() {
+    gc_config config = { .max_heap_size = LIMIT };
+    gc_init(&config);
+    //Dead buffers are collected to make room for new ones, however many are adopted.
+    for (int k = 0; k < 4*LIMIT/CHUNK; ++k) {
+        check(to_gcobj(buffer(k), CHUNK, NULL, NULL));
+        check(tenured_now() <= LIMIT);
+    }
+    //Live ones fill the heap up to the limit, and no further.
+    gcobj* live = gc_push_frame(2*LIMIT/CHUNK);
+    int k = 0;
+    for (; k < 2*LIMIT/CHUNK; ++k) {
+        void* data = buffer(k);
+        live[k] = to_gcobj(data, CHUNK, NULL, NULL);
+        if (!live[k]) {
+            //The buffer is still ours.
+            if (k % 2) free(data);
+            else gc_free_large(data);
+            break;
+        }
+        check(tenured_now() <= LIMIT);
+    }
+    check(k == LIMIT/CHUNK);
+    //Nor is there room for an object kept in its gateway.
+    long box = 0;
+    check(!new_gcobj(&box, sizeof box, NULL, NULL));
+    //Once they're let go, there's room again.
+    gc_pop_frame(live);
+    check(to_gcobj(buffer(0), CHUNK, NULL, NULL));
+    collect_all();
+    check(tenured_now() == 0);
+    gc_finish();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+/*
+ * With several markers, major collections keep exactly what's reachable, whichever thread ends up tracing it.
+ */
+#include "test.h"
+
+#define DEPTH 14
+
+typedef struct node {
+    gcobj left, right;
+    long depth;
+} node;
+
+static int dead;
+
+static void count_dead(void* obj) {
+    (void)obj;
+    ++dead;
+}
+
+static void trace_node(const void* obj) {
+    const node* n = obj;
+    if (n->left) gc_mark(n->left);
+    if (n->right) gc_mark(n->right);
+}
+
+static void trace_slot(const void* slot) {
+    gcobj x = *(const gcobj*)slot;
+    if (x) gc_mark(x);
+}
+
+#define NODES ((1 << (DEPTH + 1)) - 1)
+
+//Nodes of the tree being built, in heap order, so that they're rooted until they're linked up.
+static gcobj building[NODES];
+
+static void trace_building(const void* obj) {
+    const gcobj* at = obj;
+    for (int k = 0; k < NODES; ++k) if (at[k]) gc_mark(at[k]);
+}
+
+static gcobj make_tree() {
+    gc_root(building, trace_building);
+    for (int k = NODES; k-- > 0;) {
+        node n = { NULL, NULL, 0 };
+        if (2*k + 1 < NODES) {
+            n.left = building[2*k + 1];
+            n.right = building[2*k + 2];
+            n.depth = ((const node*)gate_data(n.left))->depth + 1;
+        }
+        building[k] = new_gcobj(&n, sizeof n, trace_node, count_dead);
+    }
+    gcobj root = building[0];
+    memset(building, 0, sizeof building);
+    gc_unroot(building);
+    return root;
+}
+
+/**
+ * Count the nodes of a tree, checking that each is as deep as it should be.
+ */
+static long count_tree(gcobj x, long depth) {
+    const node* n = gate_data(x);
+    check(n->depth == depth);
+    if (!depth) return 1;
+    return 1 + count_tree(n->left, depth - 1) + count_tree(n->right, depth - 1);
+}
+
+int main() {
+    gc_config config = { .marker_threads = 4 };
+    gc_init(&config);
+    check(getTracer()->markers);
+    gcobj live = NULL;
+    gc_root(&live, trace_slot);
+    live = make_tree();
+    long size = count_tree(live, DEPTH);
+    for (int round = 0; round < 4; ++round) {
+        //Garbage of the same shape, some of it tenured by a minor collection first.
+        gcobj garbage = make_tree();
+        gc_root(&garbage, trace_slot);
+        minor_gc();
+        gc_unroot(&garbage);
+        make_tree();
+        collect_all();
+        check(dead == 2*size*(round + 1));
+        check(count_tree(live, DEPTH) == size);
+    }
+    gc_finish();
+    check(dead == 9*size);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+/*
+ * Minor collections release dead young gateways in bulk, except for those that own something,
+ * which are still finalized and freed one at a time.
+ */
+#include "test.h"
+
+#define COUNT 3000
+
+static int dead;
+static gcobj objs[COUNT];
+
+static void count_dead(void* obj) {
+    (void)obj;
+    ++dead;
+}
+
+static void trace_objs(const void* obj) {
+    const gcobj* at = obj;
+    for (int k = 0; k < COUNT; ++k) if (at[k]) gc_mark(at[k]);
+}
+
+static bool owns(gcobj x) {
+    reg_node* node = block_of(x);
+    return test_bit(node->owning, slot_of(node, x));
+}
+
+static size_t count_filled() {
+    size_t filled = 0;
+    for (reg_list list = PARTIAL_BLOCKS; list < NUM_BLOCK_LISTS; ++list)
+        for (reg_node* node = getRegistry()->blocks[list]; node; node = node->next) filled += node->filled;
+    return filled;
+}
+
+int main() {
+    gc_init(NULL);
+    gc_root(objs, trace_objs);
+    //Plain nursery objects, finalized ones, and ones whose data was handed over from malloc.
+    int finalized = 0, adopted = 0;
+    for (int k = 0; k < COUNT; ++k) {
+        long value[2] = { k, 0 }; //too big to fit in a gateway
+        if (k % 16 == 0) {
+            objs[k] = new_gcobj(value, sizeof value, NULL, count_dead);
+            ++finalized;
+        }
+        elif (k % 16 == 1) {
+            long* data = malloc(sizeof value);
+            check(data);
+            memcpy(data, value, sizeof value);
+            objs[k] = to_gcobj(data, sizeof value, NULL, NULL);
+            ++adopted;
+        }
+        else objs[k] = new_gcobj(value, sizeof value, NULL, NULL);
+        check(owns(objs[k]) == (k % 16 < 2));
+    }
+    check(count_filled() == COUNT);
+    //Everything dies young; only the finalized ones notice.
+    memset(objs, 0, sizeof objs);
+    minor_gc();
+    check(dead == finalized && count_filled() == 0);
+    //Slots released in bulk are handed out again, cleared.
+    for (long k = 0; k < COUNT; ++k) {
+        long value[2] = { k, 0 };
+        objs[k] = new_gcobj(value, sizeof value, NULL, NULL);
+        check(!owns(objs[k]) && is_young(objs[k]));
+    }
+    //Survivors that get tenured start owning their data.
+    for (int k = 0; k < TENURE_AGE; ++k) minor_gc();
+    for (int k = 0; k < COUNT; ++k) check(owns(objs[k]) && *(const long*)gate_data(objs[k]) == k);
+    check(dead == finalized && adopted);
+    gc_finish();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+/*
+ * Pinned objects outlive their last reference until they're unpinned as many times as they were pinned,
+ * and finalizers run exactly once, on the object's data as it was last seen.
+ */
+#include "test.h"
+
+static int dead;
+static long last;
+
+static void note_dead(void* obj) {
+    ++dead;
+    last = *(long*)obj;
+}
+
+int main() {
+    gc_init(NULL);
+    long value = 7;
+    gcobj x = new_gcobj(&value, sizeof value, NULL, note_dead);
+    pin_gcobj(x);
+    pin_gcobj(x);
+    //Nothing refers to it but the pins.
+    for (int k = 0; k <= TENURE_AGE; ++k) minor_gc();
+    collect_all();
+    check(dead == 0 && *(const long*)gate_data(x) == 7);
+    unpin_gcobj(x);
+    collect_all();
+    check(dead == 0 && *(const long*)gate_data(x) == 7);
+    unpin_gcobj(x);
+    collect_all();
+    check(dead == 1 && last == 7);
+    //The rest are finalized when the collector is torn down.
+    for (long k = 0; k < 10; ++k) new_gcobj(&k, sizeof k, NULL, note_dead);
+    gc_finish();
+    check(dead == 11);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+/*
+ * Gateways are packed into registry blocks, slots freed by a sweep are handed out again before any new block is made,
+ * and blocks left empty are kept as spares only up to `REG_SPARE_BLOCKS`.
+ */
+#include "test.h"
+
+#define BLOCKS 3
+
+static gcobj* objs;
+static size_t count;
+
+static void trace_objs(const void* obj) {
+    (void)obj;
+    for (size_t k = 0; k < count; ++k) if (objs[k]) gc_mark(objs[k]);
+}
+
+static size_t list_length(reg_list list) {
+    size_t len = 0;
+    for (reg_node* node = getRegistry()->blocks[list]; node; node = node->next) ++len;
+    return len;
+}
+
+static bool in_blocks(gcobj x) {
+    for (reg_list list = PARTIAL_BLOCKS; list < NUM_BLOCK_LISTS; ++list) {
+        for (reg_node* node = getRegistry()->blocks[list]; node; node = node->next) {
+            if (x >= node->data && x < node->data + REG_BLOCK_SIZE) return true;
+        }
+    }
+    return false;
+}
+
+int main() {
+    gc_init(NULL);
+    count = BLOCKS*REG_BLOCK_SIZE;
+    objs = calloc(count, sizeof(gcobj));
+    check(objs);
+    gc_root(objs, trace_objs);
+    for (size_t k = 0; k < count; ++k) objs[k] = new_gcobj(NULL, 0, NULL, NULL);
+    check(list_length(FULL_BLOCKS) == BLOCKS && list_length(PARTIAL_BLOCKS) == 0);
+    //Every other gateway dies, leaving every block half full.
+    for (size_t k = 0; k < count; k += 2) objs[k] = NULL;
+    minor_gc();
+    check(list_length(FULL_BLOCKS) == 0 && list_length(PARTIAL_BLOCKS) == BLOCKS);
+    for (reg_node* node = getRegistry()->blocks[PARTIAL_BLOCKS]; node; node = node->next) {
+        check(node->filled == (uint)REG_BLOCK_SIZE/2);
+    }
+    //The freed slots are filled again without making a new block.
+    for (size_t k = 0; k < count; k += 2) {
+        objs[k] = new_gcobj(NULL, 0, NULL, NULL);
+        check(in_blocks(objs[k]));
+    }
+    check(list_length(FULL_BLOCKS) == BLOCKS && list_length(PARTIAL_BLOCKS) == 0);
+    //Once everything is dead, only so many empty blocks are kept.
+    memset(objs, 0, count*sizeof(gcobj));
+    collect_all();
+    check(list_length(FULL_BLOCKS) == 0 && list_length(PARTIAL_BLOCKS) == 0);
+    check(list_length(EMPTY_BLOCKS) == (size_t)getRegistry()->spare_count);
+    check(getRegistry()->spare_count == (BLOCKS < REG_SPARE_BLOCKS ? BLOCKS : REG_SPARE_BLOCKS));
+    gc_finish();
+    free(objs);
+    return 0;
+}
\ No newline at end of file
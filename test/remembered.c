@@ -0,0 +1,62 @@
+/*
+ * A young object reachable only through a tenured one that was changed in place survives minor collections,
+ * and the tenured object is forgotten once it can no longer point at anything young.
+ */
+#include "test.h"
+
+typedef struct holder {
+    gcobj child;
+} holder;
+
+static int dead;
+static gcobj pending;
+
+static void count_dead(void* obj) {
+    (void)obj;
+    ++dead;
+}
+
+static void trace_holder(const void* obj) {
+    const holder* h = obj;
+    if (h->child) gc_mark(h->child);
+}
+
+static void trace_slot(const void* slot) {
+    gcobj x = *(const gcobj*)slot;
+    if (x) gc_mark(x);
+}
+
+static void adopt(void* obj) {
+    ((holder*)obj)->child = pending;
+}
+
+int main() {
+    gc_init(NULL);
+    gcobj old = NULL;
+    gc_root(&old, trace_slot);
+    holder h = { NULL };
+    old = new_gcobj(&h, sizeof h, trace_holder, count_dead);
+    for (int k = 0; k < TENURE_AGE; ++k) minor_gc();
+    check(!is_young(old));
+    //The only path to the child is through the old object, which minor collections don't otherwise trace.
+    long value = 42;
+    pending = new_gcobj(&value, sizeof value, NULL, count_dead);
+    set_gcobj(old, adopt);
+    pending = NULL;
+    check(getTracer()->remembered.len == 1);
+    //Touching it again doesn't remember it twice.
+    gc_touch(old);
+    check(getTracer()->remembered.len == 1);
+    for (int k = 0; k < TENURE_AGE; ++k) minor_gc();
+    gcobj child = ((const holder*)gate_data(old))->child;
+    check(dead == 0 && !is_young(child) && *(const long*)gate_data(child) == 42);
+    //By now the child is tenured too, so the old object has been forgotten.
+    check(getTracer()->remembered.len == 0 && !remembered_of(old));
+    //A remembered object that dies is dropped by the major collection that frees it.
+    gc_touch(old);
+    old = NULL;
+    collect_all();
+    check(dead == 2 && getTracer()->remembered.len == 0);
+    gc_finish();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+/*
+ * The nursery, survivor spaces and tenure pages are all laid out in the thread's reserved range:
+ * the nursery grows and shrinks in place, and tenure pages given back are handed out again before fresh ones.
+ */
+#include "test.h"
+
+static bool in_range(const void* data) {
+    reserve_t* reserve = getReserve();
+    return (const byte*)data >= reserve->base && (const byte*)data < reserve->end;
+}
+
+static bool in_pages(const void* data) {
+    reserve_t* reserve = getReserve();
+    return (const byte*)data >= reserve->pages && (const byte*)data < reserve->end;
+}
+
+int main() {
+    gc_init(NULL);
+    nursery_t* nursery = getNursery();
+    //The nursery starts the range, aligned to its greatest size.
+    check(nursery->data == reserved_nursery() && nursery->data == getReserve()->base);
+    check(!((uintptr_t)nursery->data & (uintptr_t)(MAX_NURSERY_SIZE - 1)));
+    check(nursery->survivor[0].data >= reserved_survivors() && in_range(nursery->survivor[1].end - 1));
+    long cell[4] = { 1, 2, 3, 4 };
+    gcobj* held = gc_push_frame(2);
+    held[0] = new_gcobj(cell, sizeof cell, NULL, NULL);
+    check(in_nursery(held[0]->data) && space_of(held[0]) == NURSERY_SPACE);
+    check(!in_nursery(held) && !in_nursery(reserved_survivors()) && !in_nursery(nursery->data + MAX_NURSERY_SIZE));
+    //Resizing keeps it where it is.
+    size_t size = nursery_size();
+    minor_gc();
+    resize_nursery(size/2);
+    check(nursery->data == reserved_nursery() && nursery_size() == size/2);
+    resize_nursery(size);
+    check(nursery->data == reserved_nursery() && nursery_size() == size);
+    //Tenured data goes in tenure pages from the range.
+    held[1] = new_gcobj(cell, sizeof cell, NULL, NULL);
+    gc_promote(held[1]);
+    check(space_of(held[1]) == TENURE_SPACE && in_pages(held[1]->data));
+    check(!memcmp(gate_data(held[1]), cell, sizeof cell));
+    //A page taken back reads as zero, and is the next one handed out.
+    byte* page = reserve_page();
+    check(page && in_pages(page) && !((uintptr_t)page & (TENURE_PAGE_SIZE - 1)));
+    memset(page, 0xff, TENURE_PAGE_SIZE);
+    check(release_page(page));
+    check(page[RESERVE_PAGE_SIZE] == 0 && page[TENURE_PAGE_SIZE - 1] == 0);
+    check(reserve_page() == page);
+    check(release_page(page));
+    //Pages from anywhere else aren't the range's to take.
+    check(!release_page(held));
+    gc_pop_frame(held);
+    collect_all();
+    gc_finish();
+    return 0;
+}
\ No newline at end of file
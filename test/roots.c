@@ -0,0 +1,69 @@
+/*
+ * Roots added with a handle stay alive until their handle is dropped, in whatever order that happens,
+ * and shadow stack slots keep what they hold alive until their frame is popped, whoever does the marking.
+ */
+#include "test.h"
+
+#define COUNT 1000
+
+static int dead;
+static bool died[COUNT];
+
+static void count_dead(void* obj) {
+    died[*(const long*)obj] = true;
+    ++dead;
+}
+
+static gcobj object(long tag) {
+    long cell[2] = { tag, 0 }; //too big to fit in a gateway
+    return new_gcobj(cell, sizeof cell, NULL, count_dead);
+}
+
+static long tag_of(gcobj x) {
+    return *(const long*)gate_data(x);
+}
+
+static void trace_slot(const void* slot) {
+    gcobj x = *(const gcobj*)slot;
+    if (x) gc_mark(x);
+}
+
+static gcobj slots[COUNT];
+static gc_handle* handles[COUNT];
+
+int main() {
+    gc_config config = { .marker_threads = 4 };
+    gc_init(&config);
+    for (int k = 0; k < COUNT; ++k) {
+        slots[k] = object(k);
+        handles[k] = gc_add_root(&slots[k], trace_slot);
+    }
+    //Dropping from the front moves roots from the back into the gaps, so their handles must follow.
+    for (int k = 0; k < COUNT; k += 2) gc_drop_root(handles[k]);
+    collect_all();
+    check(dead == COUNT/2);
+    for (int k = 0; k < COUNT; ++k) check(died[k] == !(k%2));
+    for (int k = 1; k < COUNT; k += 2) check(tag_of(slots[k]) == k);
+    for (int k = COUNT - 1; k > 0; k -= 2) gc_drop_root(handles[k]);
+    collect_all();
+    check(dead == COUNT);
+    check(getTracer()->roots.len == 0);
+    //Frames hold through minor and major collections alike.
+    dead = 0;
+    gcobj* outer = gc_push_frame(2);
+    check(!outer[0] && !outer[1]);
+    outer[0] = object(1);
+    gcobj* inner = gc_push_frame(COUNT);
+    for (int k = 0; k < COUNT; ++k) inner[k] = object(k);
+    minor_gc();
+    collect_all();
+    check(dead == 0);
+    check(tag_of(outer[0]) == 1);
+    for (int k = 0; k < COUNT; ++k) check(tag_of(inner[k]) == k);
+    //Popping the outer frame pops the inner one along with it.
+    gc_pop_frame(outer);
+    collect_all();
+    check(dead == COUNT + 1);
+    gc_finish();
+    return 0;
+}
\ No newline at end of file
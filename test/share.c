@@ -0,0 +1,99 @@
+/*
+ * A graph sent to another thread's heap is read there in place, kept alive for as long as that heap holds it,
+ * and freed by its owner once it has been handed back.
+ */
+#include "test.h"
+#include <pthread.h>
+#include <sched.h>
+
+#define LENGTH 1000
+
+typedef struct cell {
+    gcobj next;
+    long value;
+} cell;
+
+static const size_t cell_offsets[] = { offsetof(cell, next) };
+static const gc_layout cell_layout = { .stride = 0, .count = 1, .offsets = cell_offsets };
+
+static int dead; //only ever touched by the sending thread, which runs the finalizers
+static _Atomic(gc_heap*) receiver;
+static atomic_int stage;
+
+static void count_dead(void* obj) {
+    (void)obj;
+    ++dead;
+}
+
+static void trace_slot(const void* slot) {
+    gcobj x = *(const gcobj*)slot;
+    if (x) gc_mark(x);
+}
+
+/**
+ * Check that the list holds every value from `length - 1` down to zero.
+ */
+static void check_list(gcobj x, long length) {
+    for (long k = length; k-- > 0; x = ((const cell*)gate_data(x))->next) check(((const cell*)gate_data(x))->value == k);
+    check(!x);
+}
+
+static void wait_for(int at) {
+    while (atomic_load(&stage) < at) sched_yield();
+}
+
+static void* receive(void* arg) {
+    (void)arg;
+    gc_init(NULL);
+    atomic_store(&receiver, gc_this_heap());
+    gcobj got = NULL;
+    gc_root(&got, trace_slot);
+    while (!(got = gc_receive())) sched_yield();
+    check(block_of(got)->owner != gc_this_heap());
+    check_list(got, LENGTH);
+    //Held through collections of its own, as long as it's reachable here.
+    minor_gc();
+    collect_all();
+    check_list(got, LENGTH);
+    atomic_store(&stage, 1);
+    //Let it go, which hands it back to the sender.
+    wait_for(2);
+    got = NULL;
+    collect_all();
+    atomic_store(&stage, 3);
+    wait_for(4);
+    gc_finish();
+    return NULL;
+}
+
+int main() {
+    gc_init(NULL);
+    pthread_t thread;
+    check(!pthread_create(&thread, NULL, receive, NULL));
+    gcobj head = NULL;
+    gc_root(&head, trace_slot);
+    for (long k = 0; k < LENGTH; ++k) {
+        cell c = { head, k };
+        head = new_gcobj_layout(&c, sizeof c, &cell_layout, count_dead);
+    }
+    gc_heap* to;
+    while (!(to = atomic_load(&receiver))) sched_yield();
+    gc_send(to, head);
+    //Nothing here refers to it any more, but the receiver does.
+    head = NULL;
+    collect_all();
+    check(dead == 0);
+    wait_for(1);
+    collect_all();
+    check(dead == 0);
+    atomic_store(&stage, 2);
+    //Once handed back, the next safe point unpins it, and the next collection frees it.
+    wait_for(3);
+    check(!gc_receive());
+    collect_all();
+    check(dead == LENGTH);
+    atomic_store(&stage, 4);
+    check(!pthread_join(thread, NULL));
+    gc_finish();
+    return 0;
+}
\ No newline at end of file
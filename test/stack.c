@@ -0,0 +1,80 @@
+/*
+ * The chunked mark stack copes with wide objects and long chains, whether drained all at once or a little at a time,
+ * and keeps only a few spare chunks afterwards.
+ */
+#include "test.h"
+
+#define WIDE 5000
+#define DEEP 100000
+
+typedef struct link {
+    gcobj next;
+    long value;
+} link;
+
+static const size_t link_offsets[] = { offsetof(link, next) };
+static const gc_layout link_layout = { .stride = 0, .count = 1, .offsets = link_offsets };
+static const size_t array_offsets[] = { 0 };
+static const gc_layout array_layout = { .stride = sizeof(gcobj), .count = 1, .offsets = array_offsets };
+
+static int dead;
+static gcobj wide[WIDE];
+static gcobj held[2];
+
+static void count_dead(void* obj) {
+    (void)obj;
+    ++dead;
+}
+
+static void trace_objs(const void* obj) {
+    const gcobj* at = obj;
+    for (int k = 0; k < WIDE; ++k) if (at[k]) gc_mark(at[k]);
+}
+
+static void trace_held(const void* obj) {
+    const gcobj* at = obj;
+    for (int k = 0; k < 2; ++k) if (at[k]) gc_mark(at[k]);
+}
+
+/**
+ * Check that a chain holds every value from `length - 1` down to zero.
+ */
+static void check_chain(gcobj x, long length) {
+    for (long k = length; k-- > 0; x = ((const link*)gate_data(x))->next) check(((const link*)gate_data(x))->value == k);
+    check(!x);
+}
+
+int main() {
+    gc_init(NULL);
+    gc_root(held, trace_held);
+    //A single object pointing at many short chains, so that far more than a chunk's worth is marked at once.
+    gc_root(wide, trace_objs);
+    for (int k = 0; k < WIDE; ++k) {
+        link l = { NULL, 0 };
+        wide[k] = new_gcobj_layout(&l, sizeof l, &link_layout, count_dead);
+        l = (link){ wide[k], 1 };
+        wide[k] = new_gcobj_layout(&l, sizeof l, &link_layout, count_dead);
+    }
+    held[0] = new_gcobj_layout(wide, sizeof wide, &array_layout, count_dead);
+    gc_unroot(wide);
+    //And one long chain.
+    for (long k = 0; k < DEEP; ++k) {
+        link l = { held[1], k };
+        held[1] = new_gcobj_layout(&l, sizeof l, &link_layout, count_dead);
+    }
+    check(dead == 0);
+    collect_all();
+    check(dead == 0);
+    trace_engine_t* tracer = getTracer();
+    check(stack_empty(&tracer->stack) && tracer->spare_count > 0 && tracer->spare_count <= MARK_SPARE_CHUNKS);
+    const gcobj* array = gate_data(held[0]);
+    for (int k = 0; k < WIDE; ++k) check_chain(array[k], 2);
+    check_chain(held[1], DEEP);
+    //Drained a few gateways at a time, with whatever is left over in the prefetch line going back on the stack.
+    held[0] = NULL;
+    while (!gc_step(7)) pass;
+    check(dead == 1 + 2*WIDE && stack_empty(&tracer->grey));
+    check_chain(held[1], DEEP);
+    gc_finish();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+/*
+ * Each kind of collection reports an event of its own, and the registry sizes it reports match the registry.
+ */
+#include "test.h"
+
+#define COUNT 3000
+
+static int events[3];
+static gc_event last;
+
+static void record(const gc_event* event, void* data) {
+    check(data == events);
+    events[event->kind]++;
+    last = *event;
+}
+
+static gcobj held[COUNT];
+
+static void trace_held(const void* obj) {
+    const gcobj* at = obj;
+    for (int k = 0; k < COUNT; ++k) if (at[k]) gc_mark(at[k]);
+}
+
+/**
+ * Check the sizes reported against a walk of the registry.
+ */
+static void check_counts(size_t blocks, size_t gateways) {
+    size_t walked_blocks = 0, walked_gateways = 0;
+    for (int k = 0; k < NUM_BLOCK_LISTS; ++k) {
+        for (reg_node* node = getRegistry()->blocks[k]; node; node = node->next) {
+            walked_blocks++;
+            walked_gateways += node->filled;
+        }
+    }
+    check(blocks == walked_blocks);
+    check(gateways == walked_gateways);
+}
+
+int main() {
+    gc_config config = { .profile = 1 };
+    gc_init(&config);
+    gc_root(held, trace_held);
+    gc_on_event(record, events);
+    for (int k = 0; k < COUNT; ++k) {
+        long cell[4] = { k };
+        held[k] = new_gcobj(cell, sizeof cell, NULL, NULL);
+    }
+    minor_gc();
+    check(events[GC_MINOR_EVENT] == 1);
+    check(last.kind == GC_MINOR_EVENT);
+    check(last.allocated_bytes >= COUNT*4*sizeof(long));
+    check(last.young_bytes && last.survived_bytes == last.young_bytes && last.survival_rate == 1.0);
+    check(last.gateways >= COUNT);
+    check_counts(last.blocks, last.gateways);
+    //Let half of them go.
+    for (int k = 0; k < COUNT; k += 2) held[k] = NULL;
+    collect_all();
+    check(events[GC_MAJOR_EVENT] == 1);
+    check(last.kind == GC_MAJOR_EVENT);
+    check_counts(last.blocks, last.gateways);
+    //An incremental collection reports once, after its sweep.
+    for (int k = 1; k < COUNT; k += 4) held[k] = NULL;
+    while (!gc_step(100)) check(!events[GC_INCREMENTAL_EVENT]);
+    check(events[GC_INCREMENTAL_EVENT] == 1);
+    check(last.kind == GC_INCREMENTAL_EVENT);
+    check(last.gateways <= COUNT/4 + 1);
+    check_counts(last.blocks, last.gateways);
+    gc_stats stats;
+    gc_get_stats(&stats);
+    check(stats.minor_collections == (size_t)events[GC_MINOR_EVENT]);
+    check(stats.major_collections == (size_t)(events[GC_MAJOR_EVENT] + events[GC_INCREMENTAL_EVENT]));
+    check(stats.max_pause_ns && stats.max_pause_ns <= stats.pause_ns);
+    check_counts(stats.blocks, stats.gateways);
+    //Once the callback is gone, collections are still counted, but no longer reported.
+    gc_on_event(NULL, NULL);
+    minor_gc();
+    gc_get_stats(&stats);
+    check(stats.minor_collections == (size_t)events[GC_MINOR_EVENT] + 1);
+    gc_finish();
+    return 0;
+}
\ No newline at end of file
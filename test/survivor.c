@@ -0,0 +1,64 @@
+/*
+ * Young objects wait out `TENURE_AGE` minor collections in the survivor spaces before they're tenured,
+ * unless there are too many of them to fit, in which case they're all tenured at once.
+ */
+#include "test.h"
+
+#define FEW 200
+#define CELL 32
+
+static gcobj objs[FEW];
+
+static void trace_objs(const void* obj) {
+    const gcobj* at = obj;
+    for (int k = 0; k < FEW; ++k) if (at[k]) gc_mark(at[k]);
+}
+
+static bool tenure_empty() {
+    tenure_t* tenure = getTenure();
+    for (uint c = 0; c < NUM_SIZE_CLASSES; ++c) if (tenure->partial[c] || tenure->full[c]) return false;
+    return true;
+}
+
+int main() {
+    gc_init(NULL);
+    gc_root(objs, trace_objs);
+    byte cell[CELL];
+    for (int k = 0; k < FEW; ++k) {
+        memset(cell, k, CELL);
+        objs[k] = new_gcobj(cell, CELL, NULL, NULL);
+    }
+    //Survivors are moved, but stay young until they're old enough.
+    for (int age = 1; age < TENURE_AGE; ++age) {
+        minor_gc();
+        for (int k = 0; k < FEW; ++k) {
+            check(space_of(objs[k]) == SURVIVOR_SPACE && is_young(objs[k]) && age_of(objs[k]) == age);
+            memset(cell, k, CELL);
+            check(!memcmp(gate_data(objs[k]), cell, CELL));
+        }
+    }
+    check(tenure_empty());
+    //Those that die in the meantime never take up any room in tenure.
+    for (int k = 0; k < FEW/2; ++k) objs[k] = NULL;
+    minor_gc();
+    for (int k = FEW/2; k < FEW; ++k) {
+        check(space_of(objs[k]) == TENURE_SPACE && !is_young(objs[k]));
+        memset(cell, k, CELL);
+        check(!memcmp(gate_data(objs[k]), cell, CELL));
+    }
+    check(page_of(objs[FEW/2]->data)->live == FEW/2);
+    //When the live young objects won't fit in a survivor space, they're tenured straight away.
+    memset(objs, 0, sizeof objs);
+    byte* chunk = calloc(1, SKIP_NURSERY_THRESHOLD - 1);
+    check(chunk);
+    for (int k = 0; k < FEW; ++k) objs[k] = new_gcobj(chunk, SKIP_NURSERY_THRESHOLD - 1, NULL, NULL);
+    free(chunk);
+    check((size_t)FEW*(SKIP_NURSERY_THRESHOLD - 1) > (size_t)SURVIVOR_SIZE);
+    minor_gc();
+    for (int k = 0; k < FEW; ++k) check(space_of(objs[k]) == TENURE_SPACE);
+    memset(objs, 0, sizeof objs);
+    collect_all();
+    check(tenure_empty());
+    gc_finish();
+    return 0;
+}
\ No newline at end of file
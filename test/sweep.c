@@ -0,0 +1,35 @@
+/*
+ * A major collection is over once its lazy sweep is, even when allocation rather than `gc_step` finishes that sweep.
+ */
+#include "test.h"
+
+#define LIVE 20000
+
+static long cell[2];
+static gcobj old[LIVE], young[LIVE];
+
+static void trace_objs(const void* obj) {
+    const gcobj* at = obj;
+    for (int k = 0; k < LIVE; ++k) if (at[k]) gc_mark(at[k]);
+}
+
+int main() {
+    gc_init(NULL);
+    gc_root(old, trace_objs);
+    gc_root(young, trace_objs);
+    for (int k = 0; k < LIVE; ++k) old[k] = new_gcobj(cell, sizeof(cell), NULL, NULL);
+    gc_run();
+    check(getTracer()->phase == SWEEP_PHASE);
+    check(getRegistry()->blocks[UNSWEPT_BLOCKS]);
+    //Keep everything alive, so that new gateways only find room once the sweep has been finished.
+    for (int k = 0; k < LIVE && getRegistry()->blocks[UNSWEPT_BLOCKS]; ++k)
+        young[k] = new_gcobj(cell, sizeof(cell), NULL, NULL);
+    check(!getRegistry()->blocks[UNSWEPT_BLOCKS]);
+    check(getTracer()->phase == IDLE_PHASE);
+    //So the next step starts a collection, rather than finishing one that's already over.
+    check(!gc_step(1));
+    check(getTracer()->phase != IDLE_PHASE);
+    collect_all();
+    gc_finish();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+/*
+ * Survivors are promoted into tenure pages of their size class, with their data intact,
+ * and pages are reclaimed whole once everything in them has died.
+ */
+#include "test.h"
+
+#define COUNT 3000
+
+static gcobj objs[COUNT];
+
+static void trace_objs(const void* obj) {
+    const gcobj* at = obj;
+    for (int k = 0; k < COUNT; ++k) if (at[k]) gc_mark(at[k]);
+}
+
+/**
+ * Sizes from one byte up to the largest that still goes through the nursery.
+ */
+static size_t size_of(int k) {
+    return 1 + k % (SKIP_NURSERY_THRESHOLD - 1);
+}
+
+int main() {
+    gc_init(NULL);
+    gc_root(objs, trace_objs);
+    byte buffer[TENURE_MAX_CELL];
+    for (int k = 0; k < COUNT; ++k) {
+        memset(buffer, k, size_of(k));
+        objs[k] = new_gcobj(buffer, size_of(k), NULL, NULL);
+    }
+    minor_gc();
+    for (int k = 0; k < COUNT; ++k) {
+        gcobj x = objs[k];
+        memset(buffer, k, x->bytes);
+        //The smallest are kept in their gateway, and so go nowhere.
+        if (is_inline(x)) {
+            check(space_of(x) == INLINE_SPACE && !memcmp(gate_data(x), buffer, x->bytes));
+            continue;
+        }
+        check(space_of(x) == TENURE_SPACE);
+        tenure_page* page = page_of(x->data);
+        check(page->size_class == size_class_of(x->bytes) && page->cell >= x->bytes);
+        check(!memcmp(gate_data(x), buffer, x->bytes));
+    }
+    //Objects of the same class share pages.
+    check(page_of(objs[INLINE_MAX]->data) == page_of(objs[INLINE_MAX + SKIP_NURSERY_THRESHOLD - 1]->data));
+    //Once they're all dead, no page is left in use, and only a few are kept spare.
+    memset(objs, 0, sizeof objs);
+    collect_all();
+    tenure_t* tenure = getTenure();
+    for (uint c = 0; c < NUM_SIZE_CLASSES; ++c) check(!tenure->partial[c] && !tenure->full[c]);
+    check(tenure->spare_count <= TENURE_SPARE_PAGES);
+    gc_finish();
+    return 0;
+}
\ No newline at end of file
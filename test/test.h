@@ -0,0 +1,44 @@
+/*
+ * Shared harness for the regression tests run by `make test`.
+ * Each test is a program of its own, built against the whole collector so that it can look at its internals,
+ * and exits with a failure as soon as a check doesn't hold.
+ */
+#include "impl.c"
+
+/**
+ * Fail the test, saying where, unless `cond` holds.
+ */
+#define check(cond) MACRO_STATEMENT(\
+    if (!(cond)) { error("%s:%d -- check failed: %s\n", __FILE__, __LINE__, #cond); }\
+)
+
+/**
+ * Run a major collection through to the end, so that everything dead has been finalized and freed.
+ */
+static inline void collect_all() {
+    gc_run();
+    while (!gc_step(SIZE_MAX)) pass;
+}
+
+/**
+ * Look up what the registry keeps about a gateway off to the side.
+ */
+static inline gc_space space_of(gcobj x) {
+    reg_node* node = block_of(x);
+    return node->space[slot_of(node, x)];
+}
+
+static inline bool is_young(gcobj x) {
+    reg_node* node = block_of(x);
+    return test_bit(node->young, slot_of(node, x));
+}
+
+static inline byte age_of(gcobj x) {
+    reg_node* node = block_of(x);
+    return node->age[slot_of(node, x)];
+}
+
+static inline byte remembered_of(gcobj x) {
+    reg_node* node = block_of(x);
+    return node->remembered[slot_of(node, x)];
+}
@@ -0,0 +1,86 @@
+/*
+ * Weak references are cleared once their target is otherwise unreachable, by minor and major collections alike,
+ * and an ephemeron keeps its value alive for exactly as long as its key is.
+ */
+#include "test.h"
+
+static int dead;
+
+static void count_dead(void* obj) {
+    (void)obj;
+    ++dead;
+}
+
+static gcobj object(long tag) {
+    long cell[2] = { tag, 0 }; //too big to fit in a gateway
+    return new_gcobj(cell, sizeof cell, NULL, count_dead);
+}
+
+static long tag_of(gcobj x) {
+    return *(const long*)gate_data(x);
+}
+
+static gcobj held[2];
+
+static void trace_held(const void* obj) {
+    const gcobj* at = obj;
+    for (int k = 0; k < 2; ++k) if (at[k]) gc_mark(at[k]);
+}
+
+/**
+ * Tenure whatever is held, by having it survive enough minor collections.
+ */
+static void tenure_held() {
+    for (int k = 0; k < TENURE_AGE; ++k) minor_gc();
+}
+
+int main() {
+    gc_init(NULL);
+    gc_root(held, trace_held);
+    //A young target goes with the first minor collection after its last strong reference does.
+    held[0] = object(1);
+    gc_weak* young = new_weak(held[0]);
+    minor_gc();
+    check(weak_target(young) == held[0]);
+    held[0] = NULL;
+    minor_gc();
+    check(!weak_target(young));
+    check(dead == 1);
+    //A tenured one stays through minor collections, and goes with the next major one.
+    held[0] = object(2);
+    gc_weak* old = new_weak(held[0]);
+    tenure_held();
+    held[0] = NULL;
+    for (int k = 0; k < 4; ++k) minor_gc();
+    check(weak_target(old) && tag_of(weak_target(old)) == 2);
+    collect_all();
+    check(!weak_target(old));
+    check(dead == 2);
+    //The value of an ephemeron is only held through its key.
+    held[0] = object(3);
+    tenure_held();
+    gc_weak* eph = new_ephemeron(held[0], object(4));
+    //With the key tenured, only the ephemeron leads a minor collection to the young value.
+    minor_gc();
+    check(dead == 2);
+    collect_all();
+    check(dead == 2);
+    check(tag_of(weak_value(eph)) == 4);
+    //Once the key goes, so does the value.
+    held[0] = NULL;
+    collect_all();
+    check(!weak_target(eph) && !weak_value(eph));
+    check(dead == 4);
+    //Freed entries are reused, whatever lists they were on.
+    free_weak(young);
+    free_weak(old);
+    free_weak(eph);
+    held[1] = object(5);
+    gc_weak* again = new_weak(held[1]);
+    minor_gc();
+    collect_all();
+    check(weak_target(again) == held[1]);
+    free_weak(again);
+    gc_finish();
+    return 0;
+}
\ No newline at end of file